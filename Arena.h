@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Class that allocates objects of one type from large chunks of memory
+ * Objects are placed one after another in the newest chunk (a bump allocator), and the slots
+ * of destroyed objects are reused before the chunk is, so building a graph takes a few large
+ * allocations instead of one per object, and releasing it frees a few chunks
+ *
+ * @tparam T the type of object to allocate
+ */
+template <typename T>
+class Arena {
+  public:
+    // number of objects that fit in the first chunk
+    static const size_t kFirstChunkSize = 64;
+    // largest number of objects a chunk grows to (chunks double in size until then)
+    static const size_t kMaxChunkSize = 1 << 16;
+
+    /**
+     * Default Constructor (no memory is allocated until the first object is created)
+     */
+    Arena() {}
+
+    // objects can't be shared between arenas
+    Arena(const Arena& other) = delete;
+    Arena& operator=(const Arena& rhs) = delete;
+
+    /**
+     * Creates an object in the arena
+     *
+     * @param args the arguments to give the object's constructor
+     * @return a pointer to the new object (owned by the arena)
+     */
+    template <typename... Args>
+    T* create(Args&&... args);
+
+    /**
+     * Destroys an object created by this arena, so its slot can be reused
+     *
+     * @param object pointer to the object to destroy
+     */
+    void destroy(T* object);
+
+    /**
+     * Makes sure the next num_objects objects can be created without allocating more than one chunk
+     *
+     * @param num_objects the number of objects that will be created
+     */
+    void reserve(size_t num_objects);
+
+    /**
+     * Releases every chunk at once
+     * Destructors are not run, so objects that own memory (and are not trivially destructible)
+     * must be destroyed with destroy() first
+     */
+    void clear();
+
+    /**
+     * Retrieves the number of chunks the arena has allocated
+     *
+     * @return the number of chunks
+     */
+    size_t getNumChunks() const;
+
+  private:
+    // uninitialized memory for one object
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    /**
+     * Allocates a new chunk with room for at least num_objects objects and makes it the newest chunk
+     *
+     * @param num_objects the number of objects the chunk needs room for
+     */
+    void addChunk(size_t num_objects);
+
+    // every chunk allocated by the arena
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+
+    // number of slots in the newest chunk
+    size_t chunk_size_ = 0;
+
+    // number of slots of the newest chunk that have been handed out
+    size_t num_used_ = 0;
+
+    // slots of destroyed objects, which are reused before the newest chunk
+    std::vector<Slot*> free_slots_;
+};
+
+#include "Arena.hpp"
@@ -0,0 +1,69 @@
+/**
+ * Definitions of the Arena's member functions
+ * (included at the bottom of Arena.h)
+ */
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+template <typename T>
+const size_t Arena<T>::kFirstChunkSize;
+
+template <typename T>
+const size_t Arena<T>::kMaxChunkSize;
+
+template <typename T>
+template <typename... Args>
+T* Arena<T>::create(Args&&... args) {
+  Slot* slot = nullptr;
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    if (num_used_ == chunk_size_) {
+      addChunk(chunk_size_ == 0 ? kFirstChunkSize : std::min(2 * chunk_size_, kMaxChunkSize));
+    }
+    slot = chunks_.back().get() + num_used_;
+    num_used_ += 1;
+  }
+  return new (slot) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void Arena<T>::destroy(T* object) {
+  object->~T();
+  free_slots_.push_back(reinterpret_cast<Slot*>(object));
+}
+
+template <typename T>
+void Arena<T>::reserve(size_t num_objects) {
+  size_t num_available = free_slots_.size() + (chunk_size_ - num_used_);
+  if (num_objects > num_available) {
+    addChunk(num_objects - num_available);
+  }
+}
+
+template <typename T>
+void Arena<T>::clear() {
+  chunks_.clear();
+  free_slots_.clear();
+  chunk_size_ = 0;
+  num_used_ = 0;
+}
+
+template <typename T>
+size_t Arena<T>::getNumChunks() const {
+  return chunks_.size();
+}
+
+template <typename T>
+void Arena<T>::addChunk(size_t num_objects) {
+  // the unused end of the old chunk is kept for later objects
+  for (size_t i = num_used_; i < chunk_size_; ++i) {
+    free_slots_.push_back(chunks_.back().get() + i);
+  }
+  chunks_.emplace_back(new Slot[num_objects]);
+  chunk_size_ = num_objects;
+  num_used_ = 0;
+}
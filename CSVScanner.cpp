@@ -0,0 +1,194 @@
+#include "CSVScanner.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace {
+  // powers of ten that are exactly representable as doubles
+  const double kExactPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+      1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const int kMaxExactPowerOfTen = 22;
+
+  // largest integer that every smaller integer can be exactly represented as a double (2^53)
+  const uint64_t kMaxExactMantissa = 9007199254740992ULL;
+
+  // longest field that the slow path of parseDouble will copy onto the stack
+  const size_t kMaxSlowPathLength = 63;
+
+  bool isSpace(char character) {
+    return character == ' ' || character == '\r' || character == '\t';
+  }
+
+  bool isDigit(char character) {
+    return character >= '0' && character <= '9';
+  }
+
+  /**
+   * Strips surrounding spaces and then surrounding quotes (and any spaces inside
+   * of the quotes) from a field
+   */
+  CSVScanner::Field trimField(const char* begin, const char* end) {
+    while (begin != end && isSpace(*begin)) ++begin;
+    while (begin != end && isSpace(*(end - 1))) --end;
+    if (end - begin >= 2 && *begin == '"' && *(end - 1) == '"') {
+      ++begin;
+      --end;
+      while (begin != end && isSpace(*begin)) ++begin;
+      while (begin != end && isSpace(*(end - 1))) --end;
+    }
+    CSVScanner::Field field;
+    field.begin_ = begin;
+    field.end_ = end;
+    return field;
+  }
+
+  // checks if a field is exactly the given word
+  bool isField(const CSVScanner::Field& field, const char* word) {
+    size_t length = std::strlen(word);
+    return static_cast<size_t>(field.end_ - field.begin_) == length
+        && std::memcmp(field.begin_, word, length) == 0;
+  }
+
+  // a field is empty if it has no characters other than spaces
+  bool isEmptyField(const char* begin, const char* end) {
+    for (const char* it = begin; it != end; ++it) {
+      if (!isSpace(*it)) return false;
+    }
+    return true;
+  }
+}
+
+const char* CSVScanner::findRowEnd(const char* row_begin, const char* data_end) {
+  const void* newline = std::memchr(row_begin, '\n', data_end - row_begin);
+  return newline == nullptr ? data_end : static_cast<const char*>(newline);
+}
+
+size_t CSVScanner::splitRow(const char* row_begin, const char* row_end, Field* fields) {
+  size_t num_fields = 0;
+  const char* field_begin = row_begin;
+  bool in_quotes = false;
+
+  for (const char* it = row_begin; it != row_end; ++it) {
+    if (*it == '"') {
+      in_quotes = !in_quotes;
+    } else if (*it == ',' && !in_quotes) {
+      if (num_fields == kNumColumns) return kNumColumns + 1;
+      if (isEmptyField(field_begin, it)) return 0;
+      fields[num_fields] = trimField(field_begin, it);
+      num_fields += 1;
+      field_begin = it + 1;
+    }
+  }
+  // the last field is ended by the end of the row rather than a comma
+  if (num_fields == kNumColumns) return kNumColumns + 1;
+  if (isEmptyField(field_begin, row_end)) return 0;
+  fields[num_fields] = trimField(field_begin, row_end);
+  return num_fields + 1;
+}
+
+bool CSVScanner::parseInt(const Field& field, int* value) {
+  const char* it = field.begin_;
+  bool is_negative = false;
+  if (it != field.end_ && (*it == '-' || *it == '+')) {
+    is_negative = (*it == '-');
+    ++it;
+  }
+  if (it == field.end_) return false;
+
+  long long result = 0;
+  for (; it != field.end_; ++it) {
+    if (!isDigit(*it)) return false;
+    result = result * 10 + (*it - '0');
+    if (result > std::numeric_limits<int>::max()) return false;
+  }
+  *value = static_cast<int>(is_negative ? -result : result);
+  return true;
+}
+
+bool CSVScanner::parseDouble(const Field& field, double* value) {
+  const char* it = field.begin_;
+  bool is_negative = false;
+  if (it != field.end_ && (*it == '-' || *it == '+')) {
+    is_negative = (*it == '-');
+    ++it;
+  }
+
+  uint64_t mantissa = 0;
+  int num_significant_digits = 0;
+  int num_fraction_digits = 0;
+  bool has_digits = false;
+  bool seen_decimal_point = false;
+  for (; it != field.end_; ++it) {
+    if (isDigit(*it)) {
+      has_digits = true;
+      if (mantissa != 0 || *it != '0') num_significant_digits += 1;
+      // more digits than fit in the mantissa are left to the slow path
+      if (num_significant_digits > 19) break;
+      mantissa = mantissa * 10 + (*it - '0');
+      if (seen_decimal_point) num_fraction_digits += 1;
+    } else if (*it == '.' && !seen_decimal_point) {
+      seen_decimal_point = true;
+    } else {
+      break;
+    }
+  }
+
+  // fast path: the mantissa and the power of ten are both exact, so a single division
+  // is correctly rounded (the same as strtod)
+  if (it == field.end_) {
+    if (!has_digits) return false;
+    if (mantissa <= kMaxExactMantissa && num_fraction_digits <= kMaxExactPowerOfTen) {
+      double result = static_cast<double>(mantissa) / kExactPowersOfTen[num_fraction_digits];
+      *value = is_negative ? -result : result;
+      return true;
+    }
+  }
+
+  // slow path (exponents, very long fields): copy the field onto the stack for strtod
+  size_t length = field.end_ - field.begin_;
+  if (length == 0 || length > kMaxSlowPathLength) return false;
+  char buffer[kMaxSlowPathLength + 1];
+  for (size_t i = 0; i < length; ++i) {
+    buffer[i] = field.begin_[i];
+  }
+  buffer[length] = '\0';
+  // strtod also reads hex floats, which a stringstream doesn't
+  if (std::strpbrk(buffer, "xX") != nullptr) return false;
+  char* parsed_end = nullptr;
+  double result = std::strtod(buffer, &parsed_end);
+  if (parsed_end != buffer + length) return false;
+  // nan, inf and values too large for a double would end up in edge weights and distances
+  if (!std::isfinite(result)) return false;
+  *value = result;
+  return true;
+}
+
+bool CSVScanner::parseTrip(const char* row_begin, const char* row_end, Graph::Trip* trip) {
+  Field fields[kNumColumns];
+  // ensure the data has the correct number of data points
+  if (splitRow(row_begin, row_end, fields) != kNumColumns) {
+    return false;
+  }
+
+  trip->user_type_ = Graph::kUnknownUser;
+  if (isField(fields[kUserTypeColumn], "Subscriber")) {
+    trip->user_type_ = Graph::kSubscriber;
+  } else if (isField(fields[kUserTypeColumn], "Customer")) {
+    trip->user_type_ = Graph::kCustomer;
+  }
+
+  // a row without a valid duration still adds its stations and edge to the graph
+  trip->has_duration_ = parseDouble(fields[kTripDurationColumn], &trip->duration_);
+
+  Graph::Station& start = trip->start_station_;
+  Graph::Station& end = trip->end_station_;
+  return parseInt(fields[kStartStationIdColumn], &start.id_)
+      && parseDouble(fields[kStartLatitudeColumn], &start.latitude_)
+      && parseDouble(fields[kStartLongitudeColumn], &start.longitude_)
+      && parseInt(fields[kEndStationIdColumn], &end.id_)
+      && parseDouble(fields[kEndLatitudeColumn], &end.latitude_)
+      && parseDouble(fields[kEndLongitudeColumn], &end.longitude_);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <cstddef>
+
+/**
+ * Class that splits rows of the Citi Bike trip data into fields and parses the
+ * numeric fields in place (no temporary strings or streams are created)
+ */
+class CSVScanner {
+  public:
+    // number of columns in a row of trip data
+    static const size_t kNumColumns = 15;
+
+    // columns of the data points needed to build the graph
+    static const size_t kTripDurationColumn = 0;
+    static const size_t kStartStationIdColumn = 3;
+    static const size_t kStartLatitudeColumn = 5;
+    static const size_t kStartLongitudeColumn = 6;
+    static const size_t kEndStationIdColumn = 7;
+    static const size_t kEndLatitudeColumn = 9;
+    static const size_t kEndLongitudeColumn = 10;
+    static const size_t kUserTypeColumn = 12;
+
+    /**
+     * Struct storing the characters of a single field of a row
+     * Points into the scanned row (the field is not copied)
+     */
+    struct Field {
+      // pointer to the first character of the field
+      const char* begin_ = nullptr;
+      // pointer to one past the last character of the field
+      const char* end_ = nullptr;
+    };
+
+    /**
+     * Finds the end of the row starting at the given character
+     *
+     * @param row_begin pointer to the first character of the row
+     * @param data_end pointer to one past the last character of the data
+     * @return pointer to the newline ending the row (data_end if the row is not ended by a newline)
+     */
+    static const char* findRowEnd(const char* row_begin, const char* data_end);
+
+    /**
+     * Splits a row into its fields in a single pass
+     * Commas inside of double quotes do not end a field, and surrounding spaces
+     * and quotes are stripped from each field
+     *
+     * @param row_begin pointer to the first character of the row
+     * @param row_end pointer to one past the last character of the row (not including the newline)
+     * @param fields array of at least kNumColumns Fields to write the fields of the row into
+     * @return the number of fields in the row (stops counting at kNumColumns + 1)
+     */
+    static size_t splitRow(const char* row_begin, const char* row_end, Field* fields);
+
+    /**
+     * Parses an int from a field
+     *
+     * @param field the Field to parse
+     * @param value pointer to the int to write the result into
+     * @return true if the whole field was a valid int
+     */
+    static bool parseInt(const Field& field, int* value);
+
+    /**
+     * Parses a double from a field
+     * Gives the same (correctly rounded) result as reading the field through a stringstream
+     * Values that aren't finite (nan, inf, or too large for a double) and hex floats are not valid
+     *
+     * @param field the Field to parse
+     * @param value pointer to the double to write the result into
+     * @return true if the whole field was a valid double
+     */
+    static bool parseDouble(const Field& field, double* value);
+
+    /**
+     * Parses a row of trip data
+     * A row is only used if it has exactly kNumColumns non-empty fields and all of the station
+     * data points are valid numbers
+     * A trip duration that is not a valid number sets has_duration_ to false instead of skipping the row
+     * User types other than Subscriber and Customer are read as kUnknownUser
+     *
+     * @param row_begin pointer to the first character of the row
+     * @param row_end pointer to one past the last character of the row (not including the newline)
+     * @param trip pointer to the Trip to write the parsed data into
+     * @return true if the row was valid
+     */
+    static bool parseTrip(const char* row_begin, const char* row_end, Graph::Trip* trip);
+};
@@ -0,0 +1,316 @@
+#include "ContractionHierarchy.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+const uint32_t ContractionHierarchy::kNoVertex;
+const size_t ContractionHierarchy::kMaxWitnessSettled;
+const size_t ContractionHierarchy::kMaxPriorityWitnessSettled;
+
+size_t ContractionHierarchy::size() const {
+  return verticies_.size();
+}
+
+size_t ContractionHierarchy::getNumShortcuts() const {
+  return num_shortcuts_;
+}
+
+uint32_t ContractionHierarchy::getRank(uint32_t vertex) const {
+  return ranks_[vertex];
+}
+
+void ContractionHierarchy::contract(std::vector<std::vector<Arc>> arcs) {
+  const size_t num_verticies = arcs.size();
+  ranks_.assign(num_verticies, 0);
+  std::vector<std::vector<Arc>> upward_arcs(num_verticies);
+  std::vector<bool> is_contracted(num_verticies, false);
+  std::vector<int> num_contracted_neighbors(num_verticies, 0);
+  WitnessSearch witness_search;
+  witness_search.distances_.assign(num_verticies, std::numeric_limits<double>::infinity());
+  witness_search.is_target_.assign(num_verticies, false);
+  std::vector<std::pair<uint32_t, Arc>> shortcuts;
+
+  // edge difference of a vertex, estimated with smaller witness searches
+  auto getPriority = [&](uint32_t vertex) {
+    findShortcuts(vertex, arcs, kMaxPriorityWitnessSettled, &witness_search, &shortcuts);
+    return static_cast<int>(shortcuts.size()) - static_cast<int>(arcs[vertex].size())
+        + num_contracted_neighbors[vertex];
+  };
+
+  // (priority, vertex) entries with the smallest priority on top; an entry is out of date if the
+  // vertex's priority changed after it was added
+  std::vector<int> priorities(num_verticies, 0);
+  std::priority_queue<std::pair<int, uint32_t>, std::vector<std::pair<int, uint32_t>>,
+      std::greater<std::pair<int, uint32_t>>> queue;
+  for (uint32_t vertex = 0; vertex < num_verticies; ++vertex) {
+    priorities[vertex] = getPriority(vertex);
+    queue.push(std::make_pair(priorities[vertex], vertex));
+  }
+
+  uint32_t next_rank = 0;
+  while (!queue.empty()) {
+    std::pair<int, uint32_t> entry = queue.top();
+    queue.pop();
+    uint32_t vertex = entry.second;
+    if (is_contracted[vertex] || entry.first != priorities[vertex]) {
+      continue;
+    }
+    // contractions further away may have raised the priority, so check it before contracting
+    int priority = getPriority(vertex);
+    if (priority > entry.first && !queue.empty() && priority > queue.top().first) {
+      priorities[vertex] = priority;
+      queue.push(std::make_pair(priority, vertex));
+      continue;
+    }
+
+    findShortcuts(vertex, arcs, kMaxWitnessSettled, &witness_search, &shortcuts);
+    ranks_[vertex] = next_rank;
+    next_rank += 1;
+    is_contracted[vertex] = true;
+    // every remaining neighbor is contracted later, so all of the vertex's edges go upwards
+    upward_arcs[vertex] = arcs[vertex];
+    for (const std::pair<uint32_t, Arc>& shortcut : shortcuts) {
+      Arc reverse = shortcut.second;
+      reverse.head_ = shortcut.first;
+      std::vector<Arc>& tail_arcs = arcs[shortcut.first];
+      std::vector<Arc>& head_arcs = arcs[shortcut.second.head_];
+      // a shortcut replaces a longer edge between the same verticies
+      auto existing = std::find_if(tail_arcs.begin(), tail_arcs.end(),
+          [&](const Arc& arc) { return arc.head_ == shortcut.second.head_; });
+      if (existing == tail_arcs.end()) {
+        tail_arcs.push_back(shortcut.second);
+        head_arcs.push_back(reverse);
+        num_shortcuts_ += 1;
+      } else if (shortcut.second.weight_ < existing->weight_) {
+        *existing = shortcut.second;
+        *std::find_if(head_arcs.begin(), head_arcs.end(),
+            [&](const Arc& arc) { return arc.head_ == shortcut.first; }) = reverse;
+      }
+    }
+
+    // remove the vertex from its neighbors, and update their priorities
+    for (const Arc& arc : upward_arcs[vertex]) {
+      std::vector<Arc>& neighbor_arcs = arcs[arc.head_];
+      neighbor_arcs.erase(std::find_if(neighbor_arcs.begin(), neighbor_arcs.end(),
+          [&](const Arc& neighbor_arc) { return neighbor_arc.head_ == vertex; }));
+      num_contracted_neighbors[arc.head_] += 1;
+    }
+    std::vector<Arc>().swap(arcs[vertex]);
+    for (const Arc& arc : upward_arcs[vertex]) {
+      priorities[arc.head_] = getPriority(arc.head_);
+      queue.push(std::make_pair(priorities[arc.head_], arc.head_));
+    }
+  }
+
+  upward_offsets_.reserve(num_verticies + 1);
+  upward_offsets_.push_back(0);
+  for (uint32_t vertex = 0; vertex < num_verticies; ++vertex) {
+    upward_arcs_.insert(upward_arcs_.end(), upward_arcs[vertex].begin(), upward_arcs[vertex].end());
+    upward_offsets_.push_back(static_cast<uint32_t>(upward_arcs_.size()));
+  }
+}
+
+void ContractionHierarchy::findShortcuts(uint32_t vertex, const std::vector<std::vector<Arc>>& arcs,
+    size_t max_settled, WitnessSearch* witness_search, std::vector<std::pair<uint32_t, Arc>>* shortcuts) {
+  shortcuts->clear();
+  const std::vector<Arc>& neighbors = arcs[vertex];
+  for (size_t i = 0; i + 1 < neighbors.size(); ++i) {
+    // only paths as long as the longest path through the vertex from this neighbor matter
+    double max_distance = 0;
+    for (size_t j = i + 1; j < neighbors.size(); ++j) {
+      max_distance = std::max(max_distance, neighbors[i].weight_ + neighbors[j].weight_);
+      witness_search->is_target_[neighbors[j].head_] = true;
+    }
+    searchWitnesses(neighbors[i].head_, vertex, max_distance, neighbors.size() - i - 1, max_settled, arcs,
+        witness_search);
+
+    for (size_t j = i + 1; j < neighbors.size(); ++j) {
+      witness_search->is_target_[neighbors[j].head_] = false;
+      double through_vertex = neighbors[i].weight_ + neighbors[j].weight_;
+      // a path around the vertex that is no longer makes the shortcut unnecessary
+      if (witness_search->distances_[neighbors[j].head_] > through_vertex) {
+        Arc shortcut;
+        shortcut.head_ = neighbors[j].head_;
+        shortcut.middle_ = vertex;
+        shortcut.weight_ = through_vertex;
+        shortcuts->push_back(std::make_pair(neighbors[i].head_, shortcut));
+      }
+    }
+  }
+}
+
+void ContractionHierarchy::searchWitnesses(uint32_t start, uint32_t contracted, double max_distance,
+    size_t num_targets, size_t max_settled, const std::vector<std::vector<Arc>>& arcs,
+    WitnessSearch* witness_search) {
+  std::vector<double>& distances = witness_search->distances_;
+  for (uint32_t vertex : witness_search->reached_) {
+    distances[vertex] = std::numeric_limits<double>::infinity();
+  }
+  witness_search->reached_.clear();
+
+  // the searches are small, so a lazy heap of (distance, vertex) entries is enough
+  std::vector<std::pair<double, uint32_t>>& queue = witness_search->queue_;
+  queue.clear();
+  distances[start] = 0;
+  witness_search->reached_.push_back(start);
+  queue.push_back(std::make_pair(0, start));
+  size_t num_settled = 0;
+  while (!queue.empty() && num_settled < max_settled && num_targets > 0) {
+    std::pop_heap(queue.begin(), queue.end(), std::greater<std::pair<double, uint32_t>>());
+    std::pair<double, uint32_t> entry = queue.back();
+    queue.pop_back();
+    if (entry.first > distances[entry.second]) {
+      continue;
+    }
+    if (entry.first > max_distance) {
+      break;
+    }
+    num_settled += 1;
+    // the distances to the targets are final once they are settled
+    if (witness_search->is_target_[entry.second]) {
+      num_targets -= 1;
+    }
+    for (const Arc& arc : arcs[entry.second]) {
+      if (arc.head_ == contracted) {
+        continue;
+      }
+      double new_distance = entry.first + arc.weight_;
+      if (new_distance < distances[arc.head_]) {
+        if (distances[arc.head_] == std::numeric_limits<double>::infinity()) {
+          witness_search->reached_.push_back(arc.head_);
+        }
+        distances[arc.head_] = new_distance;
+        queue.push_back(std::make_pair(new_distance, arc.head_));
+        std::push_heap(queue.begin(), queue.end(), std::greater<std::pair<double, uint32_t>>());
+      }
+    }
+  }
+}
+
+const ContractionHierarchy::Arc& ContractionHierarchy::getArc(uint32_t vertex_one, uint32_t vertex_two) const {
+  uint32_t lower = (ranks_[vertex_one] < ranks_[vertex_two]) ? vertex_one : vertex_two;
+  uint32_t higher = (lower == vertex_one) ? vertex_two : vertex_one;
+  const Arc* arc = upward_arcs_.data() + upward_offsets_[lower];
+  while (arc->head_ != higher) {
+    ++arc;
+  }
+  return *arc;
+}
+
+double ContractionHierarchy::shortestPath(Graph::VertexData* source, Graph::VertexData* target,
+    std::vector<Graph::VertexData*>* path, size_t* num_settled) const {
+  QuerySearch query_search;
+  return shortestPath(source, target, path, num_settled, &query_search);
+}
+
+double ContractionHierarchy::shortestPath(Graph::VertexData* source, Graph::VertexData* target,
+    std::vector<Graph::VertexData*>* path, size_t* num_settled, QuerySearch* query_search) const {
+  // index 0 is the search upwards from the source, index 1 is the search upwards from the target
+  // the arrays are kept for the caller's next query, and only the verticies the last query reached are reset
+  std::vector<double>* distances = query_search->distances_;
+  std::vector<uint32_t>* previous_verticies = query_search->previous_verticies_;
+  DaryHeap<4>* priority_queues = query_search->priority_queues_;
+  std::vector<uint32_t>& reached = query_search->reached_;
+  for (int side = 0; side < 2; ++side) {
+    if (distances[side].size() < verticies_.size()) {
+      distances[side].assign(verticies_.size(), std::numeric_limits<double>::infinity());
+      previous_verticies[side].assign(verticies_.size(), kNoVertex);
+      priority_queues[side].reset(verticies_.size());
+    } else {
+      for (uint32_t vertex : reached) {
+        distances[side][vertex] = std::numeric_limits<double>::infinity();
+        previous_verticies[side][vertex] = kNoVertex;
+      }
+      priority_queues[side].clear();
+    }
+  }
+  reached.clear();
+  uint32_t starts[2] = {source->index_, target->index_};
+  for (int side = 0; side < 2; ++side) {
+    distances[side][starts[side]] = 0;
+    priority_queues[side].push(starts[side], 0);
+    reached.push_back(starts[side]);
+  }
+
+  // shortest path found so far between the searches, and the highest vertex on it
+  double best_cost = std::numeric_limits<double>::infinity();
+  uint32_t meeting_vertex = kNoVertex;
+  size_t settled = 0;
+  while (!priority_queues[0].empty() || !priority_queues[1].empty()) {
+    int side = 0;
+    if (priority_queues[0].empty()) {
+      side = 1;
+    } else if (!priority_queues[1].empty() && priority_queues[1].minKey() < priority_queues[0].minKey()) {
+      side = 1;
+    }
+    // both searches are at least this far from their start, so no shorter path is left to find
+    if (priority_queues[side].minKey() >= best_cost) {
+      break;
+    }
+    uint32_t vertex = priority_queues[side].pop();
+    settled += 1;
+    std::vector<double>& side_distances = distances[side];
+    const std::vector<double>& other_distances = distances[1 - side];
+    if (side_distances[vertex] + other_distances[vertex] < best_cost) {
+      best_cost = side_distances[vertex] + other_distances[vertex];
+      meeting_vertex = vertex;
+    }
+    for (uint32_t i = upward_offsets_[vertex]; i < upward_offsets_[vertex + 1]; ++i) {
+      const Arc& arc = upward_arcs_[i];
+      double new_distance = side_distances[vertex] + arc.weight_;
+      if (new_distance < side_distances[arc.head_]) {
+        if (side_distances[arc.head_] == std::numeric_limits<double>::infinity()) {
+          reached.push_back(arc.head_);
+        }
+        side_distances[arc.head_] = new_distance;
+        previous_verticies[side][arc.head_] = vertex;
+        priority_queues[side].push(arc.head_, new_distance);
+      }
+    }
+  }
+
+  if (num_settled != nullptr) {
+    *num_settled = settled;
+  }
+  if (path == nullptr) {
+    return best_cost;
+  }
+  path->clear();
+  if (meeting_vertex == kNoVertex) {
+    return best_cost;
+  }
+
+  // the path in the hierarchy goes up from the source to the meeting vertex and down to the target
+  std::vector<uint32_t> upward_path;
+  for (uint32_t vertex = meeting_vertex; vertex != starts[0]; vertex = previous_verticies[0][vertex]) {
+    upward_path.push_back(vertex);
+  }
+  upward_path.push_back(starts[0]);
+  std::reverse(upward_path.begin(), upward_path.end());
+  for (uint32_t vertex = meeting_vertex; vertex != starts[1];) {
+    vertex = previous_verticies[1][vertex];
+    upward_path.push_back(vertex);
+  }
+
+  // replace each shortcut with the two edges it skips, until only edges of the graph are left
+  path->push_back(verticies_[upward_path[0]]);
+  std::vector<std::pair<uint32_t, uint32_t>> to_unpack;
+  for (size_t i = 1; i < upward_path.size(); ++i) {
+    to_unpack.push_back(std::make_pair(upward_path[i - 1], upward_path[i]));
+    while (!to_unpack.empty()) {
+      std::pair<uint32_t, uint32_t> edge = to_unpack.back();
+      to_unpack.pop_back();
+      uint32_t middle = getArc(edge.first, edge.second).middle_;
+      if (middle == kNoVertex) {
+        path->push_back(verticies_[edge.second]);
+      } else {
+        // the first half is unpacked first
+        to_unpack.push_back(std::make_pair(middle, edge.second));
+        to_unpack.push_back(std::make_pair(edge.first, middle));
+      }
+    }
+  }
+  return best_cost;
+}
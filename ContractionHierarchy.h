@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Graph.h"
+#include "VertexHeap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Class representing a contraction hierarchy of a Graph, for fast station to station queries
+ * Verticies are contracted (removed) one at a time, least important first. When a vertex is
+ * contracted, a shortcut edge is added between each pair of its neighbors whose shortest path
+ * went through it (unless a witness search finds another path that is no longer), so the
+ * distances between the remaining verticies don't change
+ * Every vertex gets a rank (the order it was contracted in), and a query only needs to follow
+ * edges upwards (to higher ranks) from the source and from the target until the searches meet,
+ * which settles a few hundred verticies instead of most of the graph
+ * The hierarchy is tied to the Graph it was built from (its dense vertex indices and weights),
+ * and is built again when the graph changes
+ */
+class ContractionHierarchy {
+  public:
+    // vertex index used for a missing vertex (for example, the middle vertex of an original edge)
+    static const uint32_t kNoVertex = std::numeric_limits<uint32_t>::max();
+
+    // most verticies a witness search settles before giving up (and adding the shortcut)
+    static const size_t kMaxWitnessSettled = 500;
+
+    // most verticies a witness search settles when only estimating a vertex's priority
+    static const size_t kMaxPriorityWitnessSettled = 50;
+
+    /**
+     * Class storing the state of a query, which the caller can keep between queries so each query
+     * only resets the verticies the last one reached (instead of every vertex)
+     * One QuerySearch can be used with any hierarchy, by one query at a time
+     */
+    class QuerySearch {
+      public:
+        /**
+         * Default Constructor (grows to the size of the first hierarchy it is used with)
+         */
+        QuerySearch() {}
+
+      private:
+        friend class ContractionHierarchy;
+
+        // distance from the start of each search to each vertex (infinity if not reached)
+        std::vector<double> distances_[2];
+        // previous vertex of each vertex on each search's path to it (kNoVertex if not reached)
+        std::vector<uint32_t> previous_verticies_[2];
+        // verticies waiting to be settled by each search
+        DaryHeap<4> priority_queues_[2];
+        // verticies reached by either search of the last query
+        std::vector<uint32_t> reached_;
+    };
+
+    /**
+     * Default Constructor (an empty hierarchy)
+     */
+    ContractionHierarchy() {}
+
+    /**
+     * Contracts every vertex of a graph, in order of edge difference (the number of shortcuts
+     * contracting the vertex would add, minus the number of edges it would remove, plus the
+     * number of its neighbors that were already contracted, so the contraction stays spread out)
+     * Priorities are updated lazily: a vertex's priority is checked again before it is contracted
+     *
+     * @tparam WeightFunction the weight function used for edges (see Graph::Dijkstras)
+     * @param graph the Graph to build the hierarchy of
+     * @param weight the weight function to use for edges (edges with infinite weight are left out)
+     */
+    template <typename WeightFunction = Graph::GeometricDistance>
+    explicit ContractionHierarchy(const Graph& graph, WeightFunction weight = WeightFunction());
+
+    /**
+     * Retrieves the number of verticies in the hierarchy
+     *
+     * @return the number of verticies
+     */
+    size_t size() const;
+
+    /**
+     * Retrieves the number of shortcuts added while contracting
+     *
+     * @return the number of shortcut edges
+     */
+    size_t getNumShortcuts() const;
+
+    /**
+     * Retrieves the rank of a vertex (the order it was contracted in)
+     *
+     * @param vertex the dense index of the vertex
+     * @return the rank of the vertex (0 was contracted first)
+     */
+    uint32_t getRank(uint32_t vertex) const;
+
+    /**
+     * Finds the shortest path between two verticies with a bidirectional search that only follows
+     * edges to verticies of higher rank, and then unpacks the shortcuts on the path
+     * Gives the same cost as Graph::shortestPath with the weight function the hierarchy was built with
+     *
+     * @param source a pointer to the vertex the path starts at
+     * @param target a pointer to the vertex the path ends at
+     * @param path pointer to a vector to write the verticies of the path into, from source to
+     *    target (left empty if there is no path, may be nullptr to only find the cost)
+     * @param num_settled pointer to write the number of verticies both searches settled into
+     *    (may be nullptr)
+     * @return the combined weight of the edges of the path (infinity if there is no path)
+     */
+    double shortestPath(Graph::VertexData* source, Graph::VertexData* target, std::vector<Graph::VertexData*>* path,
+        size_t* num_settled) const;
+
+    /**
+     * Finds the shortest path between two verticies (see above), reusing the state of the last
+     * query made with a QuerySearch, so many queries don't each pay to set up arrays of every vertex
+     *
+     * @param source a pointer to the vertex the path starts at
+     * @param target a pointer to the vertex the path ends at
+     * @param path pointer to a vector to write the verticies of the path into (see above)
+     * @param num_settled pointer to write the number of verticies both searches settled into
+     *    (may be nullptr)
+     * @param query_search pointer to the QuerySearch to run the query in
+     * @return the combined weight of the edges of the path (infinity if there is no path)
+     */
+    double shortestPath(Graph::VertexData* source, Graph::VertexData* target, std::vector<Graph::VertexData*>* path,
+        size_t* num_settled, QuerySearch* query_search) const;
+
+  private:
+    /**
+     * Struct storing an edge of the hierarchy (an edge of the graph, or a shortcut)
+     */
+    struct Arc {
+      // dense index of the vertex at the other end of the edge
+      uint32_t head_;
+      // dense index of the vertex a shortcut skips (kNoVertex for an edge of the graph)
+      uint32_t middle_;
+      // weight of the edge (for a shortcut, the weight of the two edges it replaces)
+      double weight_;
+    };
+
+    /**
+     * Struct storing the distances of a witness search, reused between searches so each search
+     * only resets the verticies it reached
+     */
+    struct WitnessSearch {
+      // distance from the start of the search to each vertex (infinity if not reached)
+      std::vector<double> distances_;
+      // verticies reached by the last search
+      std::vector<uint32_t> reached_;
+      // whether each vertex is one of the neighbors the search is looking for
+      std::vector<bool> is_target_;
+      // (distance, vertex) entries in min heap order
+      std::vector<std::pair<double, uint32_t>> queue_;
+    };
+
+    /**
+     * Contracts every vertex and builds the upward edges (see the constructor)
+     *
+     * @param arcs the edges of each vertex (both directions of every edge, no self loops)
+     */
+    void contract(std::vector<std::vector<Arc>> arcs);
+
+    /**
+     * Finds the shortcuts needed to contract a vertex
+     *
+     * @param vertex the dense index of the vertex to contract
+     * @param arcs the edges of each vertex that hasn't been contracted (to other such verticies)
+     * @param max_settled the most verticies each witness search settles
+     * @param witness_search the WitnessSearch to reuse
+     * @param shortcuts pointer to a vector to write the shortcuts into, as (tail, Arc) pairs
+     *    (each pair of neighbors is written once)
+     */
+    static void findShortcuts(uint32_t vertex, const std::vector<std::vector<Arc>>& arcs, size_t max_settled,
+        WitnessSearch* witness_search, std::vector<std::pair<uint32_t, Arc>>* shortcuts);
+
+    /**
+     * Searches from a vertex for paths that avoid a vertex being contracted (a Dijkstras limited
+     * by distance and by the number of verticies settled, that stops once every target is settled)
+     *
+     * @param start the dense index of the vertex to search from
+     * @param contracted the dense index of the vertex to avoid
+     * @param max_distance the longest distance worth finding
+     * @param num_targets the number of verticies marked in the WitnessSearch's is_target_
+     * @param max_settled the most verticies to settle
+     * @param arcs the edges of each vertex that hasn't been contracted
+     * @param witness_search the WitnessSearch to write the distances into
+     */
+    static void searchWitnesses(uint32_t start, uint32_t contracted, double max_distance, size_t num_targets,
+        size_t max_settled, const std::vector<std::vector<Arc>>& arcs, WitnessSearch* witness_search);
+
+    /**
+     * Finds the upward edge between two verticies (stored at the vertex with the lower rank)
+     *
+     * @param vertex_one the dense index of one of the verticies
+     * @param vertex_two the dense index of the other vertex
+     * @return a reference to the edge
+     */
+    const Arc& getArc(uint32_t vertex_one, uint32_t vertex_two) const;
+
+    // verticies of the graph the hierarchy was built from, by dense index
+    std::vector<Graph::VertexData*> verticies_;
+
+    // rank of each vertex
+    std::vector<uint32_t> ranks_;
+
+    // index of the first upward edge of each vertex (with one extra entry at the end)
+    std::vector<uint32_t> upward_offsets_;
+
+    // edges of every vertex to verticies of higher rank (the edges of vertex v are at
+    // upward_offsets_[v] to upward_offsets_[v + 1])
+    std::vector<Arc> upward_arcs_;
+
+    // number of shortcuts added while contracting
+    size_t num_shortcuts_ = 0;
+};
+
+#include "ContractionHierarchy.hpp"
@@ -0,0 +1,24 @@
+/**
+ * Definitions of the ContractionHierarchy's template member functions
+ * (included at the bottom of ContractionHierarchy.h)
+ */
+
+template <typename WeightFunction>
+ContractionHierarchy::ContractionHierarchy(const Graph& graph, WeightFunction weight)
+    : verticies_(graph.getVertexList()) {
+  std::vector<std::vector<Arc>> arcs(verticies_.size());
+  for (Graph::VertexData* vertex : verticies_) {
+    for (Graph::Edge* edge : vertex->adjacent_edges_) {
+      double edge_weight = weight(edge);
+      if (edge_weight == std::numeric_limits<double>::infinity()) {
+        continue;
+      }
+      Arc arc;
+      arc.head_ = edge->getOtherVertex(vertex)->index_;
+      arc.middle_ = kNoVertex;
+      arc.weight_ = edge_weight;
+      arcs[vertex->index_].push_back(arc);
+    }
+  }
+  contract(std::move(arcs));
+}
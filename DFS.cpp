@@ -1,21 +1,15 @@
 #include "DFS.h"
 
-DFS::DFS(Graph* graph, Graph::VertexData* first_vertex) {
+DFS::DFS(const Graph* graph, Graph::VertexData* first_vertex) {
   vertex_map_ = graph->getVertexMap();
   graph_ = graph;
 
-  // set all verticies as unexplored
-  for (std::pair<int, Graph::VertexData*> vertex : vertex_map_) {
-    vertex.second->label_ = Graph::kUnexplored;
-  }
+  // set all verticies and edges as unexplored
+  vertex_labels_.assign(graph_->size(), Graph::kUnexplored);
+  edge_labels_.assign(graph_->getNumEdges(), Graph::kUnexplored);
 
-  std::list<Graph::Edge*> edges = graph_->getEdgeList();
-  // set all edges as unexplored
-  for (Graph::Edge* edge : edges) {
-    edge->label_ = Graph::kUnexplored;
-  }
   // mark the starting vertex as visited and add it to the stack
-  first_vertex->label_ = Graph::kVisited;
+  vertex_labels_[first_vertex->index_] = Graph::kVisited;
   stack_.push(first_vertex);
   index_in_map_ = 1;
   num_connected_components = 1;
@@ -42,13 +36,13 @@ DFS::Iterator& DFS::Iterator::operator++() {
     } else {
       other_vertex = edge->end_vertex_;
     }
-    if (other_vertex->label_ == Graph::kUnexplored) {
-      other_vertex->label_ = Graph::kVisited;
-      edge->label_ = Graph::kDiscovery;
+    if (dfs_->vertex_labels_[other_vertex->index_] == Graph::kUnexplored) {
+      dfs_->vertex_labels_[other_vertex->index_] = Graph::kVisited;
+      dfs_->edge_labels_[edge->index_] = Graph::kDiscovery;
       dfs_->add(other_vertex);
 
-    } else if (edge->label_ == Graph::kUnexplored) {
-      edge->label_ = Graph::kBack;
+    } else if (dfs_->edge_labels_[edge->index_] == Graph::kUnexplored) {
+      dfs_->edge_labels_[edge->index_] = Graph::kBack;
     }
   }
   return *this;
@@ -66,8 +60,8 @@ void DFS::checkVerticiesAllExplored() {
     return;
   }
  for (auto it = vertex_map_.begin(); it != vertex_map_.end(); ++it) {
-    if ((*it).second->label_ == Graph::kUnexplored) {
-      (*it).second->label_ = Graph::kVisited;
+    if (vertex_labels_[(*it).second->index_] == Graph::kUnexplored) {
+      vertex_labels_[(*it).second->index_] = Graph::kVisited;
        stack_.push((*it).second);
        index_in_map_ += 1;
        num_connected_components += 1;
@@ -128,3 +122,11 @@ void DFS::pop() {
 size_t DFS::getNumConnectedComponents() {
   return num_connected_components;
 }
+
+Graph::Label DFS::getVertexLabel(const Graph::VertexData* vertex) const {
+  return vertex_labels_[vertex->index_];
+}
+
+Graph::Label DFS::getEdgeLabel(const Graph::Edge* edge) const {
+  return edge_labels_[edge->index_];
+}
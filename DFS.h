@@ -7,6 +7,11 @@
 #include <vector>
 
 
+/**
+ * Class representing a DFS traversal of a Graph
+ * The labels of the verticies and edges are kept in the traversal (by dense index), not in the
+ * graph, so many traversals of one graph can run at the same time
+ */
 class DFS {
   public:
     /**
@@ -15,7 +20,7 @@ class DFS {
      * @param Graph* a pointer to the graph to be traversed
      * @param VertexData* a pointer to the starting vertex of the traversal
      */
-    DFS(Graph* graph, Graph::VertexData* starting_vertex);
+    DFS(const Graph* graph, Graph::VertexData* starting_vertex);
 
     /*
      * A foward iterator through a Graph (DFS Traversal)
@@ -109,9 +114,26 @@ class DFS {
       */
      size_t getNumConnectedComponents();
 
+     /**
+      * Retrieves the label the traversal gave a vertex
+      *
+      * @param vertex a pointer to a vertex of the graph being traversed
+      * @return kVisited if the vertex has been reached, kUnexplored otherwise
+      */
+     Graph::Label getVertexLabel(const Graph::VertexData* vertex) const;
+
+     /**
+      * Retrieves the label the traversal gave an edge
+      *
+      * @param edge a pointer to an edge of the graph being traversed
+      * @return kDiscovery if the edge led to a new vertex, kBack if it led to a vertex that was
+      *    already reached, kUnexplored if it hasn't been looked at yet
+      */
+     Graph::Label getEdgeLabel(const Graph::Edge* edge) const;
+
     private: 
       // Stores the graph being traversed
-      Graph* graph_;
+      const Graph* graph_;
 
       /**
        * Map storing the verticies of the graph being traversed
@@ -123,6 +145,12 @@ class DFS {
       // Stack storing the verticies to be travered
       std::stack<Graph::VertexData*> stack_;
 
+      // label of each vertex, by dense vertex index
+      std::vector<Graph::Label> vertex_labels_;
+
+      // label of each edge, by dense edge index
+      std::vector<Graph::Label> edge_labels_;
+
       /**
        * size_t storing the next index in the map to check if traversed
        * serves to ensure graphs with multiple connected components are 
@@ -0,0 +1,73 @@
+#include "DisjointSet.h"
+
+#include <utility>
+
+DisjointSet::DisjointSet(size_t num_elements) {
+  reset(num_elements);
+}
+
+void DisjointSet::reset(size_t num_elements) {
+  parents_.resize(num_elements);
+  for (size_t i = 0; i < num_elements; ++i) {
+    parents_[i] = static_cast<uint32_t>(i);
+  }
+  ranks_.assign(num_elements, 0);
+  num_sets_ = num_elements;
+}
+
+uint32_t DisjointSet::addElement() {
+  uint32_t element = static_cast<uint32_t>(parents_.size());
+  parents_.push_back(element);
+  ranks_.push_back(0);
+  num_sets_ += 1;
+  return element;
+}
+
+uint32_t DisjointSet::find(uint32_t element) {
+  uint32_t root = getSet(element);
+  // second pass to point the elements on the path at the root
+  while (parents_[element] != root) {
+    uint32_t parent = parents_[element];
+    parents_[element] = root;
+    element = parent;
+  }
+  return root;
+}
+
+uint32_t DisjointSet::getSet(uint32_t element) const {
+  while (parents_[element] != element) {
+    element = parents_[element];
+  }
+  return element;
+}
+
+bool DisjointSet::unite(uint32_t element_one, uint32_t element_two) {
+  uint32_t root_one = find(element_one);
+  uint32_t root_two = find(element_two);
+  if (root_one == root_two) {
+    return false;
+  }
+  if (ranks_[root_one] < ranks_[root_two]) {
+    std::swap(root_one, root_two);
+  }
+  parents_[root_two] = root_one;
+  if (ranks_[root_one] == ranks_[root_two]) {
+    ranks_[root_one] += 1;
+  }
+  num_sets_ -= 1;
+  return true;
+}
+
+void DisjointSet::compressPaths() {
+  for (size_t i = 0; i < parents_.size(); ++i) {
+    find(static_cast<uint32_t>(i));
+  }
+}
+
+size_t DisjointSet::size() const {
+  return parents_.size();
+}
+
+size_t DisjointSet::getNumSets() const {
+  return num_sets_;
+}
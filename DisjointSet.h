@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class representing a disjoint set (union-find) of dense indices, used to keep track of the
+ * connected components of a Graph as its edges are added
+ * Sets are joined by rank (the shorter tree goes under the taller one), and find points every
+ * element it walks past straight at the root, so any sequence of operations takes nearly
+ * constant time per operation
+ */
+class DisjointSet {
+  public:
+    /**
+     * Default Constructor (no elements)
+     */
+    DisjointSet() {}
+
+    /**
+     * Creates a disjoint set where each element is in its own set
+     *
+     * @param num_elements the number of elements
+     */
+    explicit DisjointSet(size_t num_elements);
+
+    /**
+     * Replaces every set with one set for each element
+     *
+     * @param num_elements the number of elements
+     */
+    void reset(size_t num_elements);
+
+    /**
+     * Adds an element in a set of its own
+     *
+     * @return the index of the new element
+     */
+    uint32_t addElement();
+
+    /**
+     * Finds the root of an element's set, pointing every element on the way straight at the root
+     *
+     * @param element the index of the element
+     * @return the index of the root of the element's set
+     */
+    uint32_t find(uint32_t element);
+
+    /**
+     * Finds the root of an element's set without changing the set (so it can be called from many
+     * threads at the same time)
+     * Takes one step if compressPaths was called since the last unite
+     *
+     * @param element the index of the element
+     * @return the index of the root of the element's set
+     */
+    uint32_t getSet(uint32_t element) const;
+
+    /**
+     * Joins the sets of two elements
+     *
+     * @param element_one the index of one of the elements
+     * @param element_two the index of the other element
+     * @return true if the elements were in different sets, false if they were already in the same set
+     */
+    bool unite(uint32_t element_one, uint32_t element_two);
+
+    /**
+     * Points every element straight at the root of its set
+     */
+    void compressPaths();
+
+    /**
+     * Retrieves the number of elements
+     *
+     * @return the number of elements
+     */
+    size_t size() const;
+
+    /**
+     * Retrieves the number of sets
+     *
+     * @return the number of sets
+     */
+    size_t getNumSets() const;
+
+  private:
+    // parent of each element (the root of a set is its own parent)
+    std::vector<uint32_t> parents_;
+
+    // upper bound on the height of the tree under each root
+    std::vector<uint8_t> ranks_;
+
+    // number of sets
+    size_t num_sets_ = 0;
+};
@@ -1,8 +1,25 @@
-#include "DFS.h"
+#include "CSVScanner.h"
 #include "Graph.h"
+#include "MappedFile.h"
+#include "Snapshot.h"
+#include "StaticGraph.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cmath>
-#include <limits.h>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+
+// edges are released with the chunks of their arena, without being destroyed one by one
+static_assert(std::is_trivially_destructible<Graph::Edge>::value, "Graph::Edge must be trivially destructible");
+
+const size_t Graph::kMaxHeldKarpVerticies;
 
 bool Graph::VertexData::isAdjacentVertex(VertexData* other_vertex) const {
   for (Edge* edge : adjacent_edges_) {
@@ -21,6 +38,44 @@ Graph::VertexData* Graph::Edge::getOtherVertex(VertexData* vertex) const {
   }
 }
 
+void Graph::EdgeStats::addTrip(const Trip& trip, bool is_forward) {
+  if (!trip.has_duration_) {
+    return;
+  }
+  if (is_forward) {
+    num_forward_trips_ += 1;
+  } else {
+    num_backward_trips_ += 1;
+  }
+  total_duration_ += trip.duration_;
+  min_duration_ = std::min(min_duration_, trip.duration_);
+  max_duration_ = std::max(max_duration_, trip.duration_);
+  if (trip.user_type_ == kSubscriber) {
+    num_subscriber_trips_ += 1;
+  } else if (trip.user_type_ == kCustomer) {
+    num_customer_trips_ += 1;
+  }
+}
+
+void Graph::EdgeStats::merge(const EdgeStats& other, bool is_same_direction) {
+  num_forward_trips_ += is_same_direction ? other.num_forward_trips_ : other.num_backward_trips_;
+  num_backward_trips_ += is_same_direction ? other.num_backward_trips_ : other.num_forward_trips_;
+  total_duration_ += other.total_duration_;
+  min_duration_ = std::min(min_duration_, other.min_duration_);
+  max_duration_ = std::max(max_duration_, other.max_duration_);
+  num_subscriber_trips_ += other.num_subscriber_trips_;
+  num_customer_trips_ += other.num_customer_trips_;
+}
+
+size_t Graph::EdgeStats::getNumTrips() const {
+  return num_forward_trips_ + num_backward_trips_;
+}
+
+double Graph::EdgeStats::getMeanDuration() const {
+  if (getNumTrips() == 0) return 0;
+  return total_duration_ / getNumTrips();
+}
+
 double Graph::Edge::getEdgeDistance() const {
   double latitude_difference = start_vertex_->station_.latitude_ - end_vertex_->station_.latitude_;
   double longitude_difference = start_vertex_->station_.longitude_ - end_vertex_->station_.longitude_;
@@ -45,14 +100,20 @@ Graph& Graph::operator=(const Graph& rhs) {
 }
 
 void Graph::copy(const Graph& other) {
-  for (std::pair<int, VertexData*> vertex : other.verticies_) {
-   insertVertex(vertex.second->station_);
+  // verticies are inserted in index order, so each copy has the same index as its original
+  verticies_.reserve(other.verticies_.size());
+  station_indices_.reserve(other.station_indices_.size());
+  vertex_arena_.reserve(other.verticies_.size());
+  edge_arena_.reserve(other.edges_.size());
+  for (VertexData* vertex : other.verticies_) {
+   insertVertex(vertex->station_);
   }
   for (Edge* edge : other.edges_) {
-    VertexData* vertex_one = verticies_[edge->start_vertex_->station_.id_];
-    VertexData* vertex_two = verticies_[edge->end_vertex_->station_.id_];
-    insertEdge(vertex_one, vertex_two);
+    VertexData* vertex_one = verticies_[edge->start_vertex_->index_];
+    VertexData* vertex_two = verticies_[edge->end_vertex_->index_];
+    insertEdge(vertex_one, vertex_two)->stats_ = edge->stats_;
   }
+  components_.compressPaths();
 }
 
 void Graph::destroy() {
@@ -60,258 +121,637 @@ void Graph::destroy() {
   if (verticies_.empty()) {
     return;
   }
-  for (std::pair<int, VertexData*> element : verticies_) {
-   VertexData* to_delete = element.second;
-   delete to_delete;
+  for (VertexData* to_delete : verticies_) {
+   vertex_arena_.destroy(to_delete);
   }
-  // delete each edge
-  for (Edge* edge : edges_) {
-    delete edge;
-  } 
+  // release the memory of every vertex and edge at once
+  vertex_arena_.clear();
+  edge_arena_.clear();
   if (largest_hamiltonian_ != nullptr) {
     delete largest_hamiltonian_;
   }
+  if (long_hamiltonian_ != nullptr) {
+    delete long_hamiltonian_;
+  }
+  // reset the containers so the graph can be reused (by operator=)
+  verticies_.clear();
+  station_indices_.clear();
+  edges_.clear();
+  edge_index_.clear();
+  components_.reset(0);
+  largest_hamiltonian_ = nullptr;
+  long_hamiltonian_ = nullptr;
+  total_distance_ = 0;
 }
 
-void Graph::insertVertex(Station station_to_add) {
+Graph::VertexData* Graph::insertVertex(Station station_to_add) {
   // don't allow repeated vertexes (or else there will be a memory leak)
-  auto to_return_iter = verticies_.find(station_to_add.id_);
-  if (to_return_iter != verticies_.end()) {
-    return;
+  auto inserted = station_indices_.emplace(station_to_add.id_, static_cast<uint32_t>(verticies_.size()));
+  if (!inserted.second) {
+    return verticies_[inserted.first->second];
   }
   std::list<Edge*> adjacent_edges_;
-  verticies_[station_to_add.id_] = new VertexData(station_to_add, adjacent_edges_);
+  VertexData* new_vertex = vertex_arena_.create(station_to_add, adjacent_edges_);
+  new_vertex->index_ = inserted.first->second;
+  verticies_.push_back(new_vertex);
+  components_.addElement();
+  return new_vertex;
 }
 
 Graph::VertexData* Graph::getVertex(int station_id) {
-  auto to_return_iter = verticies_.find(station_id);
-  if (to_return_iter == verticies_.end()) {
+  auto index_iter = station_indices_.find(station_id);
+  if (index_iter == station_indices_.end()) {
     return nullptr;
   } else {
-    return to_return_iter->second;
+    return verticies_[index_iter->second];
   }
 }
 
+Graph::VertexData* Graph::getVertexByIndex(uint32_t index) const {
+  return verticies_[index];
+}
+
 std::map<int, Graph::VertexData*> Graph::getVertexMap() const {
+  std::map<int, VertexData*> vertex_map;
+  for (VertexData* vertex : verticies_) {
+    vertex_map.emplace_hint(vertex_map.end(), vertex->station_.id_, vertex);
+  }
+  return vertex_map;
+}
+
+const std::vector<Graph::VertexData*>& Graph::getVertexList() const {
   return verticies_;
 }
 
+std::vector<Graph::VertexData*> Graph::getVerticiesById() const {
+  std::vector<VertexData*> sorted_verticies(verticies_);
+  std::sort(sorted_verticies.begin(), sorted_verticies.end(), [](const VertexData* one, const VertexData* two) {
+    return one->station_.id_ < two->station_.id_;
+  });
+  return sorted_verticies;
+}
+
 std::list<Graph::Edge*> Graph::getEdgeList() const {
-  return edges_;
+  return std::list<Edge*>(edges_.begin(), edges_.end());
 }
 
-void Graph::insertEdge(VertexData* vertex_one, VertexData* vertex_two) {
+size_t Graph::getNumEdges() const {
+  return edges_.size();
+}
+
+Graph::Edge* Graph::insertEdge(VertexData* vertex_one, VertexData* vertex_two) {
   // ensure no self-loops are formed
   if (vertex_one == vertex_two) {
-    return;
+    return nullptr;
   }
-  Edge* new_edge = new Edge(vertex_one, vertex_two);
+  Edge* new_edge = edge_arena_.create(vertex_one, vertex_two);
+  new_edge->index_ = static_cast<uint32_t>(edges_.size());
 
   vertex_one->adjacent_edges_.push_back(new_edge);
   vertex_two->adjacent_edges_.push_back(new_edge);
   edges_.push_back(new_edge);
+  // duplicate edges keep the first edge between the verticies in the index
+  edge_index_.emplace(getStationPairKey(vertex_one->station_.id_, vertex_two->station_.id_), new_edge);
+  components_.unite(vertex_one->index_, vertex_two->index_);
   total_distance_ += new_edge->getEdgeDistance();
+  return new_edge;
 }
 
-void Graph::insertEdgeFromData(VertexData* vertex_one, VertexData* vertex_two) {
+Graph::Edge* Graph::insertEdgeFromData(VertexData* vertex_one, VertexData* vertex_two) {
   // ensure no self-loops are formed
   if (vertex_one == vertex_two) {
-    return;
+    return nullptr;
   }
-  Edge* new_edge = new Edge(vertex_one, vertex_two);
   // ensure no duplicate edges are created
-  std::list<Edge*> vertex_one_edges = vertex_one->adjacent_edges_;
-  for (Edge* edge : vertex_one_edges) {
-    if (edge->start_vertex_ == vertex_one || edge->end_vertex_ == vertex_one) {
-      if (edge->start_vertex_ == vertex_two || edge->end_vertex_ == vertex_two) {
-        delete new_edge;
-        return;
-      }
-    }
+  Edge* existing_edge = getEdge(vertex_one, vertex_two);
+  if (existing_edge != nullptr) {
+    return existing_edge;
+  }
+  return insertEdge(vertex_one, vertex_two);
+}
+
+Graph::Edge* Graph::getEdge(VertexData* vertex_one, VertexData* vertex_two) const {
+  auto edge_iter = edge_index_.find(getStationPairKey(vertex_one->station_.id_, vertex_two->station_.id_));
+  if (edge_iter == edge_index_.end()) {
+    return nullptr;
+  }
+  return edge_iter->second;
+}
+
+
+double Graph::LoadStats::getBytesPerSecond() const {
+  if (seconds_ <= 0) return 0;
+  return num_bytes_ / seconds_;
+}
+
+void Graph::insertTrip(const Trip& trip) {
+  // create vertexes (overlap accounted for in insert vertex)
+  VertexData* start_vertex = insertVertex(trip.start_station_);
+  VertexData* end_vertex = insertVertex(trip.end_station_);
+
+  // add edge between the stations (overlap and self loop accounted for in insert edge)
+  Edge* edge = insertEdgeFromData(start_vertex, end_vertex);
+  if (edge != nullptr) {
+    edge->stats_.addTrip(trip, edge->start_vertex_ == start_vertex);
+  }
+}
+
+void Graph::insertTripSummary(const TripSummary& summary) {
+  const Trip& trip = summary.first_trip_;
+  VertexData* start_vertex = insertVertex(trip.start_station_);
+  VertexData* end_vertex = insertVertex(trip.end_station_);
+
+  Edge* edge = insertEdgeFromData(start_vertex, end_vertex);
+  if (edge != nullptr) {
+    edge->stats_.merge(summary.stats_, edge->start_vertex_ == start_vertex);
   }
-  vertex_one->adjacent_edges_.push_back(new_edge);
-  vertex_two->adjacent_edges_.push_back(new_edge);
-  edges_.push_back(new_edge);
-  total_distance_ += new_edge->getEdgeDistance();
 }
 
+Graph::LoadStats Graph::addDataFromFile(std::string file_path) {
+  auto start_time = std::chrono::steady_clock::now();
+  LoadStats stats;
+  stats.file_path_ = file_path;
 
-void Graph::addDataFromFile(std::string file_path) {
   std::string data;
   std::ifstream data_file(file_path);
-  const std::regex separate_by_commas("[^,]*");
+  stats.is_missing_ = !data_file.is_open();
   bool is_first_line = true;
+  Trip trip;
 
   while (std::getline(data_file, data)) {
+    // count the newline removed by getline
+    stats.num_bytes_ += data.size() + 1;
     // skip first line of data (with headers)
     if (is_first_line) {
       is_first_line = false;
       continue;
     }
 
-    // remove spaces from line (and data)
-    auto without_space = std::remove(data.begin(), data.end(), ' ');
-    data.erase(without_space, data.end());
+    stats.num_rows_ += 1;
+    // skip lines without the correct data points
+    if (!CSVScanner::parseTrip(data.data(), data.data() + data.size(), &trip)) {
+      stats.num_rejected_rows_ += 1;
+      continue;
+    }
+    insertTrip(trip);
+  }
+  // getline stops at an I/O error the same way it stops at the end of the file
+  stats.has_read_error_ = data_file.bad();
+  // point every station straight at its component, so getComponent is a single lookup
+  components_.compressPaths();
+
+  stats.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return stats;
+}
 
-    // separate data points by commas
-    std::sregex_iterator tester = std::sregex_iterator(data.begin(), data.end(), separate_by_commas);
-    std::sregex_iterator end = std::sregex_iterator();
+Graph::LoadStats Graph::addDataFromMappedFile(std::string file_path) {
+  auto start_time = std::chrono::steady_clock::now();
+  LoadStats stats;
+  stats.file_path_ = file_path;
+  bool is_first_line = true;
 
-    // ensure the data has the correct number of data points (2 * num rows data)
-    if (std::distance(tester, end) != 30) {
-      continue;
+  MappedFile data_file(file_path, true);
+  stats.is_missing_ = !data_file.isOpen();
+  if (data_file.isMapped()) {
+    addDataFromRows(data_file.data(), data_file.data() + data_file.size(), true, &is_first_line, &stats);
+    stats.num_bytes_ = data_file.size();
+
+  } else if (data_file.isOpen()) {
+    // the file can't be mapped (for example, a pipe), so read it through a buffer
+    // and carry any partial row at the end of the buffer over to the next read
+    const size_t kBufferSize = 1 << 20;
+    std::vector<char> buffer(kBufferSize);
+    size_t num_buffered = 0;
+    while (true) {
+      if (num_buffered == buffer.size()) {
+        // a single row is longer than the buffer
+        buffer.resize(buffer.size() * 2);
+      }
+      ssize_t num_read = read(data_file.getFileDescriptor(), buffer.data() + num_buffered,
+          buffer.size() - num_buffered);
+      if (num_read < 0 && errno == EINTR) continue;
+      if (num_read < 0) {
+        // stop at the error, leaving out the partial row at the end of the buffer
+        stats.has_read_error_ = true;
+        break;
+      }
+      bool is_end_of_data = (num_read == 0);
+      if (num_read > 0) {
+        num_buffered += num_read;
+        stats.num_bytes_ += num_read;
+      }
+      const char* unread = addDataFromRows(buffer.data(), buffer.data() + num_buffered, is_end_of_data,
+          &is_first_line, &stats);
+      if (is_end_of_data) break;
+      size_t num_unread = buffer.data() + num_buffered - unread;
+      std::memmove(buffer.data(), unread, num_unread);
+      num_buffered = num_unread;
     }
+  }
+  components_.compressPaths();
+
+  stats.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return stats;
+}
+
+Graph::LoadStats Graph::addDataFromFile(std::string file_path, size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  MappedFile data_file(file_path, true);
+  if (num_threads == 1 || !data_file.isMapped()) {
+    return addDataFromMappedFile(file_path);
+  }
 
-    int data_counter = 0;
-    // variables storing the locations int the iterator of the necessary data points
-    const int kStartStationId = 6;
-    const int kStartLatitude = 10;
-    const int kStartLongitude = 12;
-    const int kEndStationId = 14;
-    const int kEndLatitude = 18;
-    const int kEndLongitude = 20;
-    // variables storing the necessary data points
-    int start_station_id;
-    double start_station_latitude;
-    double start_station_longitude;
-    int end_station_id;
-    double end_station_latitude;
-    double end_station_longitude;
+  auto start_time = std::chrono::steady_clock::now();
+  LoadStats stats;
+  stats.file_path_ = file_path;
+  stats.num_bytes_ = data_file.size();
 
-    for (auto i = tester; i != end; ++i) {
-      if (data_counter == kStartStationId) {
-        std::string start_station_id_str = (*i).str();
-        std::stringstream stringstream(start_station_id_str);
-        stringstream >> start_station_id;
+  // skip first line of data (with headers)
+  const char* data_end = data_file.data() + data_file.size();
+  const char* data_begin = CSVScanner::findRowEnd(data_file.data(), data_end);
+  if (data_begin != data_end) ++data_begin;
 
-      } else if (data_counter == kStartLatitude) {
-        std::string latitude = (*i).str();
-        std::stringstream stringstream(latitude);
-        stringstream >> start_station_latitude;
+  // split the rows into chunks that start and end on a newline
+  std::vector<const char*> chunk_bounds = {data_begin};
+  size_t chunk_size = (data_end - data_begin) / num_threads + 1;
+  for (size_t i = 1; i < num_threads; ++i) {
+    // clamp the offset before adding it, since a pointer past the end of the data is undefined
+    size_t offset = std::min<size_t>(i * chunk_size, data_end - data_begin);
+    const char* bound = std::max(chunk_bounds.back(), data_begin + offset);
+    bound = CSVScanner::findRowEnd(bound, data_end);
+    chunk_bounds.push_back(bound == data_end ? data_end : bound + 1);
+  }
+  chunk_bounds.push_back(data_end);
+
+  std::vector<std::vector<TripSummary>> chunk_summaries(num_threads);
+  std::vector<LoadStats> chunk_stats(num_threads);
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers.emplace_back(parseTripSummaries, chunk_bounds[i], chunk_bounds[i + 1], &chunk_summaries[i],
+        &chunk_stats[i]);
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // merge the chunks in file order so the graph matches a serial read
+  for (size_t i = 0; i < num_threads; ++i) {
+    for (const TripSummary& summary : chunk_summaries[i]) {
+      insertTripSummary(summary);
+    }
+    stats.num_rows_ += chunk_stats[i].num_rows_;
+    stats.num_rejected_rows_ += chunk_stats[i].num_rejected_rows_;
+  }
+  components_.compressPaths();
 
-      } else if (data_counter == kStartLongitude) {
-        std::string longitude = (*i).str();
-        std::stringstream stringstream(longitude);
-        stringstream >> start_station_longitude;
+  stats.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return stats;
+}
 
-      } else if (data_counter == kEndStationId) {
-        std::string end_station_id_str = (*i).str();
-        std::stringstream stringstream(end_station_id_str);
-        stringstream >> end_station_id;
+std::vector<Graph::LoadStats> Graph::addDataFromFiles(const std::vector<std::string>& file_paths,
+    size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_threads = std::min(num_threads, std::max<size_t>(1, file_paths.size()));
 
-      } else if (data_counter == kEndLatitude) {
-        std::string end_latitude = (*i).str();
-        std::stringstream stringstream(end_latitude);
-        stringstream >> end_station_latitude;
+  std::vector<std::vector<TripSummary>> file_summaries(file_paths.size());
+  std::vector<LoadStats> file_stats(file_paths.size());
+  std::vector<bool> is_parsed(file_paths.size(), false);
+  // index of the next file for a worker to read
+  size_t next_file = 0;
+  // number of files merged into the graph so far
+  size_t num_merged = 0;
+  std::mutex mutex;
+  std::condition_variable file_parsed;
+  std::condition_variable file_merged;
 
-      } else if (data_counter == kEndLongitude) {
-        std::string end_longitude = (*i).str();
-        std::stringstream stringstream(end_longitude);
-        stringstream >> end_station_longitude;
+  auto read_files = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (next_file < file_paths.size()) {
+      // wait for room in the queue of parsed files
+      if (next_file >= num_merged + num_threads) {
+        file_merged.wait(lock);
+        continue;
       }
-      data_counter += 1;
+      size_t file = next_file;
+      next_file += 1;
+      lock.unlock();
+      std::vector<TripSummary> summaries;
+      LoadStats stats = parseTripSummariesFromFile(file_paths[file], &summaries);
+      lock.lock();
+      file_summaries[file].swap(summaries);
+      file_stats[file] = stats;
+      is_parsed[file] = true;
+      file_parsed.notify_all();
     }
-    // create stations
-    Station station_one = Station(start_station_id, start_station_latitude, start_station_longitude);
-    Station station_two = Station(end_station_id, end_station_latitude, end_station_longitude);
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers.emplace_back(read_files);
+  }
 
-    // create vertexes (overlap accounted for in insert vertex)
-    insertVertex(station_one);
-    insertVertex(station_two);
+  // merge the files in the order given
+  for (size_t file = 0; file < file_paths.size(); ++file) {
+    std::vector<TripSummary> summaries;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      file_parsed.wait(lock, [&]() { return is_parsed[file]; });
+      summaries.swap(file_summaries[file]);
+    }
+    auto start_time = std::chrono::steady_clock::now();
+    for (const TripSummary& summary : summaries) {
+      insertTripSummary(summary);
+    }
+    file_stats[file].seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    num_merged += 1;
+    file_merged.notify_all();
+  }
 
-    // add edge between the stations (overlap and self loop accounted for in insert edge)
-    insertEdgeFromData(verticies_[start_station_id], verticies_[end_station_id]);
+  for (std::thread& worker : workers) {
+    worker.join();
   }
+  components_.compressPaths();
+  return file_stats;
 }
 
-bool Graph::isConnected() {
-  // graph with no vertexes is not connected
-  if (verticies_.size() == 0) return false;
+Graph::LoadStats Graph::parseTripSummariesFromFile(const std::string& file_path,
+    std::vector<TripSummary>* summaries) {
+  auto start_time = std::chrono::steady_clock::now();
+  LoadStats stats;
+  stats.file_path_ = file_path;
+
+  MappedFile data_file(file_path, true);
+  stats.is_missing_ = !data_file.isOpen();
+  const char* data_begin = data_file.data();
+  const char* data_end = data_file.data() + data_file.size();
+  std::vector<char> buffer;
+  if (data_file.isOpen() && !data_file.isMapped()) {
+    // the file can't be mapped (for example, a pipe), so read all of it into a buffer
+    const size_t kReadSize = 1 << 20;
+    while (true) {
+      size_t num_buffered = buffer.size();
+      buffer.resize(num_buffered + kReadSize);
+      ssize_t num_read = read(data_file.getFileDescriptor(), buffer.data() + num_buffered, kReadSize);
+      if (num_read < 0 && errno == EINTR) {
+        buffer.resize(num_buffered);
+        continue;
+      }
+      buffer.resize(num_buffered + std::max<ssize_t>(num_read, 0));
+      if (num_read < 0) {
+        stats.has_read_error_ = true;
+      }
+      if (num_read <= 0) break;
+    }
+    data_begin = buffer.data();
+    data_end = buffer.data() + buffer.size();
+  }
+  stats.num_bytes_ = data_end - data_begin;
+  if (stats.has_read_error_) {
+    // leave out the partial row read before the error, the same as a buffered read
+    while (data_end != data_begin && data_end[-1] != '\n') {
+      --data_end;
+    }
+  }
 
-  // complete dfs traversal
-  DFS dfs = DFS(this, verticies_.begin()->second);
-  for (auto it = dfs.begin(); it != dfs.end(); ++it) {
-    // exit early if more than 1 connected components
-    if (dfs.getNumConnectedComponents() != 1) return false;
+  // skip first line of data (with headers)
+  if (data_begin != data_end) {
+    data_begin = CSVScanner::findRowEnd(data_begin, data_end);
+    if (data_begin != data_end) ++data_begin;
   }
+  parseTripSummaries(data_begin, data_end, summaries, &stats);
 
-  return (dfs.getNumConnectedComponents() == 1);
+  stats.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return stats;
 }
 
-int Graph::isEulerian() {
-  // unconnected graph is not Eulerian
-  if (!isConnected()) return 0;
-
-  // count number of vertices with odd degree
-  int odd_count = 0;
-  std::map<int, VertexData*>::iterator it;
-  for (it = verticies_.begin(); it != verticies_.end(); it++) {
-    if (it->second->adjacent_edges_.size() % 2 == 1) {
-      ++odd_count;
+void Graph::parseTripSummaries(const char* begin, const char* end, std::vector<TripSummary>* summaries,
+    LoadStats* stats) {
+  // index of the summary of each unordered pair of stations seen in this chunk
+  std::unordered_map<uint64_t, size_t> summary_indices;
+  Trip trip;
+  const char* row_begin = begin;
+  while (row_begin != end) {
+    const char* row_end = CSVScanner::findRowEnd(row_begin, end);
+    stats->num_rows_ += 1;
+    if (CSVScanner::parseTrip(row_begin, row_end, &trip)) {
+      auto inserted = summary_indices.emplace(getStationPairKey(trip.start_station_.id_, trip.end_station_.id_),
+          summaries->size());
+      if (inserted.second) {
+        summaries->push_back(TripSummary());
+        summaries->back().first_trip_ = trip;
+      }
+      TripSummary& summary = (*summaries)[inserted.first->second];
+      summary.stats_.addTrip(trip, summary.first_trip_.start_station_.id_ == trip.start_station_.id_);
+    } else {
+      stats->num_rejected_rows_ += 1;
     }
+    row_begin = (row_end == end) ? end : row_end + 1;
   }
+}
 
-  // if odd count is more than 2, graph cannot be Eulerian
-  if (odd_count > 2) return 0;
+void Graph::buildPath(VertexData* source, VertexData* target, const std::vector<VertexData*>& previous_verticies,
+    std::vector<VertexData*>* path) {
+  // count the verticies of the path, then fill it in from the target back to the source
+  size_t path_length = 1;
+  for (VertexData* vertex = target; vertex != source; vertex = previous_verticies[vertex->index_]) {
+    path_length += 1;
+  }
+  path->resize(path_length);
+  VertexData* vertex = target;
+  for (size_t i = path_length; i > 0; --i) {
+    (*path)[i - 1] = vertex;
+    vertex = previous_verticies[vertex->index_];
+  }
+}
 
-  // if odd count is 2, graph has Eulerian Path (is Semi-Eulerian)
-  if (odd_count == 2) return 1;
+Graph::VertexData* Graph::ShortestPathTree::getSource() const {
+  return source_;
+}
 
-  // odd count is 0, meaning graph has Eulerian Cycle
-  // odd count cannot be 1 for undirected graph
-  return 2;
+double Graph::ShortestPathTree::getDistance(const VertexData* vertex) const {
+  return distances_[vertex->index_];
 }
 
+Graph::VertexData* Graph::ShortestPathTree::getParent(const VertexData* vertex) const {
+  return parents_[vertex->index_];
+}
 
-std::pair<Graph, std::map<int, Graph::VertexData*>> Graph::Dijkstras(Graph::VertexData* starting_vertex) {
-  boost::heap::fibonacci_heap<VertexData*, boost::heap::compare<compareVertex>> priority_queue;
+const std::vector<double>& Graph::ShortestPathTree::getDistances() const {
+  return distances_;
+}
 
-  std::map<int, VertexData*> previous_verticies_map;
+const std::vector<Graph::VertexData*>& Graph::ShortestPathTree::getParents() const {
+  return parents_;
+}
 
-  // Mark all verticies as unexplored, set all previous verticies to nullptr, 
-  // and set all distances to +inf
-  for (std::pair<int, Graph::VertexData*> vertex : verticies_) {
-    vertex.second->label_ = Graph::Label::kUnexplored;
-    previous_verticies_map[vertex.first] = nullptr;
-    vertex.second->distance_ = std::numeric_limits<double>::infinity();
-    vertex.second->handle = priority_queue.push(vertex.second);
+double Graph::ShortestPathTree::getPath(VertexData* target, std::vector<VertexData*>* path) const {
+  path->clear();
+  double distance = distances_[target->index_];
+  if (distance == std::numeric_limits<double>::infinity()) {
+    return distance;
   }
+  buildPath(source_, target, parents_, path);
+  return distance;
+}
 
-  Graph minimum_spanning_tree;
-  // set starting vertex distance to 0 and update the priority queue
-  starting_vertex->distance_ = 0;
-  priority_queue.update(starting_vertex->handle, starting_vertex);
+const Graph& Graph::ShortestPathTree::toGraph() const {
+  std::call_once(tree_graph_->is_built_, [this]() {
+    tree_graph_->graph_ = std::make_shared<Graph>();
+    Graph* tree_graph = tree_graph_->graph_.get();
+    if (graph_ == nullptr) {
+      return;
+    }
+    // the tree graph's verticies are indexed in settled order, so a vertex's previous vertex is
+    // found by looking up the index it was given
+    std::vector<uint32_t> tree_indices(distances_.size());
+    for (uint32_t vertex_index : settled_order_) {
+      VertexData* vertex = graph_->verticies_[vertex_index];
+      VertexData* created_vertex = tree_graph->insertVertex(vertex->station_);
+      tree_indices[vertex_index] = created_vertex->index_;
+      VertexData* parent = parents_[vertex_index];
+      if (parent != nullptr) {
+        // the edge must join verticies of the tree graph (an edge to a vertex of the searched
+        // graph would be added to that graph's adjacency lists)
+        tree_graph->insertEdge(created_vertex, tree_graph->verticies_[tree_indices[parent->index_]]);
+      }
+    }
+    // verticies that can't be reached are in the tree on their own
+    for (VertexData* vertex : graph_->verticies_) {
+      if (distances_[vertex->index_] == std::numeric_limits<double>::infinity()) {
+        tree_graph->insertVertex(vertex->station_);
+      }
+    }
+  });
+  return *tree_graph_->graph_;
+}
 
-  while (priority_queue.empty() == false) {
-    // insert current vertex into the MST and update the priority queue
-    VertexData* current_vertex = priority_queue.top();
-    priority_queue.pop();
-    minimum_spanning_tree.insertVertex(current_vertex->station_);
-    VertexData* created_vertex = minimum_spanning_tree.getVertex(current_vertex->station_.id_);
-    // NOTE: this is done because previous vertex must correspond with the current graph (not MST graph)
-    VertexData* previous_vertex = previous_verticies_map[current_vertex->station_.id_];
+uint64_t Graph::getStationPairKey(int station_one_id, int station_two_id) {
+  uint32_t smaller_id = static_cast<uint32_t>(std::min(station_one_id, station_two_id));
+  uint32_t larger_id = static_cast<uint32_t>(std::max(station_one_id, station_two_id));
+  return (static_cast<uint64_t>(smaller_id) << 32) | larger_id;
+}
 
-    if (previous_vertex != nullptr) {
-      minimum_spanning_tree.insertEdge(created_vertex, previous_vertex);
+const char* Graph::addDataFromRows(const char* begin, const char* end, bool is_end_of_data,
+    bool* is_first_line, LoadStats* stats) {
+  Trip trip;
+  const char* row_begin = begin;
+  while (row_begin != end) {
+    const char* row_end = CSVScanner::findRowEnd(row_begin, end);
+    if (row_end == end && !is_end_of_data) {
+      // the rest of the row has not been read yet
+      return row_begin;
     }
 
-    for (Edge* edge : current_vertex->adjacent_edges_) {
-      VertexData* other_vertex = edge->getOtherVertex(current_vertex);
-      if (other_vertex->label_ == Graph::Label::kVisited) {
-        continue;
-      }
-      // update vertex if this distance is smaller (but not if it is equal)
-      if (edge->getEdgeDistance() + current_vertex->distance_ < other_vertex->distance_) {
-        other_vertex->distance_ = edge->getEdgeDistance() + current_vertex->distance_;
-        previous_verticies_map[other_vertex->station_.id_] = current_vertex;
-        priority_queue.update(other_vertex->handle, other_vertex);
+    // skip first line of data (with headers)
+    if (*is_first_line) {
+      *is_first_line = false;
+    } else {
+      stats->num_rows_ += 1;
+      if (CSVScanner::parseTrip(row_begin, row_end, &trip)) {
+        insertTrip(trip);
+      } else {
+        stats->num_rejected_rows_ += 1;
       }
     }
-    current_vertex->label_ = Graph::Label::kVisited;
+    row_begin = (row_end == end) ? end : row_end + 1;
+  }
+  return end;
+}
+
+StaticGraph Graph::freeze() const {
+  return StaticGraph(*this);
+}
+
+bool Graph::saveSnapshot(const std::string& file_path, const std::vector<std::string>& source_file_paths) const {
+  std::vector<Snapshot::SourceFile> source_files;
+  if (!Snapshot::findSourceFiles(source_file_paths, &source_files)) {
+    return false;
+  }
+  StaticGraph frozen = freeze();
+  // the frozen graph's verticies are in order of station id
+  std::vector<uint32_t> static_indices(verticies_.size());
+  for (VertexData* vertex : verticies_) {
+    static_indices[vertex->index_] = frozen.getVertexIndex(vertex->station_.id_);
+  }
+
+  std::vector<Snapshot::EdgeRecord> edges;
+  edges.reserve(edges_.size());
+  for (Edge* edge : edges_) {
+    Snapshot::EdgeRecord record;
+    record.start_vertex_ = static_indices[edge->start_vertex_->index_];
+    record.end_vertex_ = static_indices[edge->end_vertex_->index_];
+    record.stats_ = edge->stats_;
+    edges.push_back(record);
+  }
+  return Snapshot::write(file_path, frozen, edges, source_files);
+}
+
+bool Graph::loadSnapshot(const std::string& file_path) {
+  Snapshot snapshot(file_path);
+  if (!snapshot.isValid()) {
+    return false;
+  }
+  const Snapshot::Header& header = snapshot.getHeader();
+  vertex_arena_.reserve(header.num_verticies_);
+  edge_arena_.reserve(header.num_edges_);
+
+  std::vector<VertexData*> snapshot_verticies(header.num_verticies_);
+  for (uint64_t i = 0; i < header.num_verticies_; ++i) {
+    snapshot_verticies[i] = insertVertex(snapshot.getStations()[i]);
+  }
+  for (uint64_t i = 0; i < header.num_edges_; ++i) {
+    const Snapshot::EdgeRecord& record = snapshot.getEdges()[i];
+    VertexData* start_vertex = snapshot_verticies[record.start_vertex_];
+    Edge* edge = insertEdgeFromData(start_vertex, snapshot_verticies[record.end_vertex_]);
+    if (edge != nullptr) {
+      edge->stats_.merge(record.stats_, edge->start_vertex_ == start_vertex);
+    }
+  }
+  components_.compressPaths();
+  return true;
+}
+
+bool Graph::isConnected() const {
+  // graph with no vertexes has no components, so it is not connected
+  return components_.getNumSets() == 1;
+}
+
+size_t Graph::getNumConnectedComponents() const {
+  return components_.getNumSets();
+}
+
+uint32_t Graph::getComponent(VertexData* station) const {
+  return components_.getSet(station->index_);
+}
+
+int Graph::isEulerian() const {
+  // unconnected graph is not Eulerian
+  if (!isConnected()) return 0;
+
+  // count number of vertices with odd degree
+  int odd_count = 0;
+  for (VertexData* vertex : verticies_) {
+    if (vertex->adjacent_edges_.size() % 2 == 1) {
+      ++odd_count;
+    }
   }
-  return std::make_pair(minimum_spanning_tree, previous_verticies_map);
+
+  // if odd count is more than 2, graph cannot be Eulerian
+  if (odd_count > 2) return 0;
+
+  // if odd count is 2, graph has Eulerian Path (is Semi-Eulerian)
+  if (odd_count == 2) return 1;
+
+  // odd count is 0, meaning graph has Eulerian Cycle
+  // odd count cannot be 1 for undirected graph
+  return 2;
 }
 
+
 void Graph::removeVertex(Graph::VertexData* to_remove) {
   if (to_remove == nullptr) {
     return;
@@ -319,108 +759,803 @@ void Graph::removeVertex(Graph::VertexData* to_remove) {
   // delete all adjacent edges of the vertex
   while (!(to_remove->adjacent_edges_.empty())) {
     total_distance_ -= to_remove->adjacent_edges_.front()->getEdgeDistance();
-    edges_.remove(to_remove->adjacent_edges_.front());
+    // move the last edge into the removed edge's index so the indices stay dense
+    Edge* last_edge = edges_.back();
+    last_edge->index_ = to_remove->adjacent_edges_.front()->index_;
+    edges_[last_edge->index_] = last_edge;
+    edges_.pop_back();
     Graph::VertexData* other_vertex = to_remove->adjacent_edges_.front()->getOtherVertex(to_remove);
+    auto index_iter = edge_index_.find(getStationPairKey(to_remove->station_.id_, other_vertex->station_.id_));
+    if (index_iter != edge_index_.end() && index_iter->second == to_remove->adjacent_edges_.front()) {
+      edge_index_.erase(index_iter);
+    }
     other_vertex->adjacent_edges_.remove(to_remove->adjacent_edges_.front());
-    delete to_remove->adjacent_edges_.front();
+    edge_arena_.destroy(to_remove->adjacent_edges_.front());
     to_remove->adjacent_edges_.pop_front();
   }
+  // move the last vertex into the removed vertex's index so the indices stay dense
+  VertexData* last_vertex = verticies_.back();
+  last_vertex->index_ = to_remove->index_;
+  verticies_[last_vertex->index_] = last_vertex;
+  station_indices_[last_vertex->station_.id_] = last_vertex->index_;
+  verticies_.pop_back();
+
   // delete the vertex
-  verticies_.erase(to_remove->station_.id_);
-  delete to_remove;
+  station_indices_.erase(to_remove->station_.id_);
+  vertex_arena_.destroy(to_remove);
+  rebuildComponents();
+}
+
+void Graph::rebuildComponents() {
+  components_.reset(verticies_.size());
+  for (Edge* edge : edges_) {
+    components_.unite(edge->start_vertex_->index_, edge->end_vertex_->index_);
+  }
+  components_.compressPaths();
 }
 
 size_t Graph::size() const {
   return verticies_.size();
 }
 
-Graph* Graph::getLargestHamiltonianCycle() {
-  // label all verticies as unexplored
-  for (std::pair<int, Graph::VertexData*> vertex : verticies_) {
-    vertex.second->label_ = Graph::Label::kUnexplored;
+Graph* Graph::getLargestHamiltonianCycle(size_t num_threads) {
+  std::vector<VertexData*> cycle;
+  findLargestHamiltonianCycle(&cycle, num_threads);
+  if (cycle.empty()) {
+    return largest_hamiltonian_;
   }
-  
-  Graph::VertexData* start = getVertex(verticies_.begin()->second->station_.id_);
-  start->label_ = Graph::Label::kVisited;
-
-  Graph* hamiltonian = new Graph();
-  hamiltonian->insertVertex(start->station_);
-  Graph::VertexData* hamiltonian_start = hamiltonian->getVertex(verticies_.begin()->second->station_.id_);
 
-  getHamiltonianCycle(hamiltonian_start, hamiltonian, start, start, hamiltonian_start);
+  // build a graph of the largest cycle only once the search is done
+  Graph* hamiltonian = buildCycleGraph(cycle);
 
-  delete hamiltonian;
+  // keep the result in the graph (it is freed with the graph), unless an earlier search found a larger cycle
+  if (largest_hamiltonian_ == nullptr || hamiltonian->getTotalDistance() > largest_hamiltonian_->getTotalDistance()) {
+    delete largest_hamiltonian_;
+    largest_hamiltonian_ = hamiltonian;
+  } else {
+    delete hamiltonian;
+  }
   return largest_hamiltonian_;
 }
 
-void Graph::updateLargestHamiltonain(Graph* to_check) {
-  if (largest_hamiltonian_ == nullptr) {
-    largest_hamiltonian_ = new Graph(*to_check);
+double Graph::findLargestHamiltonianCycle(std::vector<VertexData*>* cycle, size_t num_threads,
+    size_t* num_explored) const {
+  cycle->clear();
+  if (num_explored != nullptr) {
+    *num_explored = 0;
+  }
+  size_t num_verticies = verticies_.size();
+  if (num_verticies == 0) {
+    return -std::numeric_limits<double>::infinity();
+  }
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // copy the edges into flat arrays, starting from the station with the smallest id
+  HamiltonianGraph graph;
+  graph.num_verticies_ = num_verticies;
+  for (VertexData* vertex : verticies_) {
+    if (vertex->station_.id_ < verticies_[graph.start_]->station_.id_) {
+      graph.start_ = vertex->index_;
+    }
+  }
+  graph.closing_weights_.assign(num_verticies, -std::numeric_limits<double>::infinity());
+  std::vector<uint32_t> last_seen_from(num_verticies, std::numeric_limits<uint32_t>::max());
+  graph.offsets_.push_back(0);
+  for (VertexData* vertex : verticies_) {
+    for (Edge* edge : vertex->adjacent_edges_) {
+      uint32_t other_vertex = edge->getOtherVertex(vertex)->index_;
+      // duplicate edges lead to the same subtree
+      if (last_seen_from[other_vertex] == vertex->index_) {
+        continue;
+      }
+      last_seen_from[other_vertex] = vertex->index_;
+      graph.neighbors_.push_back(other_vertex);
+      graph.weights_.push_back(edge->getEdgeDistance());
+      if (other_vertex == graph.start_) {
+        graph.closing_weights_[vertex->index_] = edge->getEdgeDistance();
+      }
+    }
+    graph.offsets_.push_back(static_cast<uint32_t>(graph.neighbors_.size()));
+    for (uint32_t i = graph.offsets_[vertex->index_]; i < graph.neighbors_.size(); ++i) {
+      graph.visit_order_.push_back(i);
+    }
+    std::stable_sort(graph.visit_order_.begin() + graph.offsets_[vertex->index_], graph.visit_order_.end(),
+        [&](uint32_t one, uint32_t two) { return graph.weights_[one] > graph.weights_[two]; });
+  }
+
+  // find the heaviest edges of each vertex for the bound on the edges left to add
+  graph.heaviest_weights_.assign(num_verticies, 0);
+  graph.two_heaviest_weights_.assign(num_verticies, 0);
+  std::vector<uint32_t> degrees(num_verticies);
+  double total_weight_bound = 0;
+  for (uint32_t vertex = 0; vertex < num_verticies; ++vertex) {
+    degrees[vertex] = graph.offsets_[vertex + 1] - graph.offsets_[vertex];
+    // every vertex of a cycle (of more than two verticies) has two neighbors
+    if (num_verticies > 2 && degrees[vertex] < 2) {
+      return -std::numeric_limits<double>::infinity();
+    }
+    double heaviest = 0;
+    double second_heaviest = 0;
+    for (uint32_t i = graph.offsets_[vertex]; i < graph.offsets_[vertex + 1]; ++i) {
+      if (graph.weights_[i] > heaviest) {
+        second_heaviest = heaviest;
+        heaviest = graph.weights_[i];
+      } else if (graph.weights_[i] > second_heaviest) {
+        second_heaviest = graph.weights_[i];
+      }
+    }
+    // a cycle of two verticies uses its one edge twice
+    if (degrees[vertex] == 1) {
+      second_heaviest = heaviest;
+    }
+    graph.heaviest_weights_[vertex] = heaviest;
+    graph.two_heaviest_weights_[vertex] = heaviest + second_heaviest;
+    total_weight_bound += heaviest + second_heaviest;
+  }
 
-  } else if (to_check->getTotalDistance() > largest_hamiltonian_->getTotalDistance()) {
-    delete largest_hamiltonian_;
-    largest_hamiltonian_ = nullptr;
-    largest_hamiltonian_ = new Graph(*to_check);
-  } 
+  // split the search tree into subtrees (paths from the start), a level at a time in depth first order,
+  // until there are enough to keep every thread busy
+  // every subtree's path has the same number of verticies, so the paths are kept back to back in one array
+  size_t task_path_size = 1;
+  std::vector<uint32_t> task_paths = {graph.start_};
+  std::vector<uint32_t> task_path_edges;
+  std::vector<double> task_weights = {0};
+  size_t num_tasks_wanted = num_threads == 1 ? 1 : num_threads * 32;
+  while (task_weights.size() < num_tasks_wanted && task_path_size < num_verticies) {
+    std::vector<uint32_t> next_paths;
+    std::vector<uint32_t> next_path_edges;
+    std::vector<double> next_weights;
+    for (size_t task = 0; task < task_weights.size(); ++task) {
+      std::vector<uint32_t>::const_iterator path = task_paths.begin() + task * task_path_size;
+      std::vector<uint32_t>::const_iterator path_edges = task_path_edges.begin() + task * (task_path_size - 1);
+      uint32_t last = path[task_path_size - 1];
+      for (uint32_t i = graph.offsets_[last]; i < graph.offsets_[last + 1]; ++i) {
+        if (std::find(path, path + task_path_size, graph.neighbors_[i]) == path + task_path_size) {
+          next_paths.insert(next_paths.end(), path, path + task_path_size);
+          next_paths.push_back(graph.neighbors_[i]);
+          next_path_edges.insert(next_path_edges.end(), path_edges, path_edges + task_path_size - 1);
+          next_path_edges.push_back(i);
+          next_weights.push_back(task_weights[task] + graph.weights_[i]);
+        }
+      }
+    }
+    task_path_size += 1;
+    task_paths.swap(next_paths);
+    task_path_edges.swap(next_path_edges);
+    task_weights.swap(next_weights);
+    if (task_weights.empty()) {
+      return -std::numeric_limits<double>::infinity();
+    }
+  }
+
+  // deal the subtrees out to the threads in order, so each thread starts on neighboring subtrees
+  size_t num_tasks = task_weights.size();
+  num_threads = std::min(num_threads, num_tasks);
+  std::vector<std::deque<size_t>> queues(num_threads);
+  std::vector<std::mutex> queue_mutexes(num_threads);
+  for (size_t task = 0; task < num_tasks; ++task) {
+    queues[task * num_threads / num_tasks].push_back(task);
+  }
+
+  // each thread sizes its path state once, and only copies into it while searching
+  std::atomic<double> best_weight(-std::numeric_limits<double>::infinity());
+  std::vector<HamiltonianSearch> searches(num_threads);
+  auto search_subtrees = [&](size_t worker) {
+    HamiltonianSearch& search = searches[worker];
+    search.path_.assign(num_verticies, 0);
+    search.path_edges_.assign(num_verticies - 1, 0);
+    search.best_cycle_.assign(num_verticies, 0);
+    search.best_cycle_edges_.assign(num_verticies - 1, 0);
+    search.is_visited_.assign(num_verticies, false);
+    search.usable_degrees_.assign(num_verticies, 0);
+    search.reached_by_.assign(num_verticies, 0);
+    search.reach_stack_.reserve(num_verticies);
+    while (true) {
+      // take the next subtree from the front of this thread's queue, or steal one from the back of another's
+      size_t task = num_tasks;
+      for (size_t i = 0; i < num_threads && task == num_tasks; ++i) {
+        size_t victim = (worker + i) % num_threads;
+        std::lock_guard<std::mutex> lock(queue_mutexes[victim]);
+        if (queues[victim].empty()) {
+          continue;
+        }
+        if (victim == worker) {
+          task = queues[victim].front();
+          queues[victim].pop_front();
+        } else {
+          task = queues[victim].back();
+          queues[victim].pop_back();
+        }
+      }
+      if (task == num_tasks) {
+        return;
+      }
+
+      // every vertex of the path but its ends is no longer usable by its neighbors
+      search.path_size_ = task_path_size;
+      std::copy(task_paths.begin() + task * task_path_size, task_paths.begin() + (task + 1) * task_path_size,
+          search.path_.begin());
+      std::copy(task_path_edges.begin() + task * (task_path_size - 1),
+          task_path_edges.begin() + (task + 1) * (task_path_size - 1), search.path_edges_.begin());
+      std::fill(search.is_visited_.begin(), search.is_visited_.end(), false);
+      std::copy(degrees.begin(), degrees.end(), search.usable_degrees_.begin());
+      search.unvisited_weight_bound_ = total_weight_bound;
+      for (size_t i = 0; i < task_path_size; ++i) {
+        uint32_t vertex = search.path_[i];
+        search.is_visited_[vertex] = true;
+        search.unvisited_weight_bound_ -= graph.two_heaviest_weights_[vertex];
+        if (i + 1 < task_path_size && vertex != graph.start_) {
+          for (uint32_t j = graph.offsets_[vertex]; j < graph.offsets_[vertex + 1]; ++j) {
+            search.usable_degrees_[graph.neighbors_[j]] -= 1;
+          }
+        }
+      }
+      extendHamiltonianPath(graph, task_weights[task], &search, &best_weight);
+    }
+  };
+  if (num_threads == 1) {
+    search_subtrees(0);
+  } else {
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < num_threads; ++i) {
+      workers.emplace_back(search_subtrees, i);
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // the largest cycle with the smallest path edges (the one a single thread would have kept)
+  size_t best_worker = 0;
+  for (size_t worker = 0; worker < num_threads; ++worker) {
+    const HamiltonianSearch& search = searches[worker];
+    if (num_explored != nullptr) {
+      *num_explored += search.num_explored_;
+    }
+    if (search.best_weight_ > searches[best_worker].best_weight_
+        || (search.best_weight_ == searches[best_worker].best_weight_
+        && search.best_cycle_edges_ < searches[best_worker].best_cycle_edges_)) {
+      best_worker = worker;
+    }
+  }
+  if (searches[best_worker].best_weight_ == -std::numeric_limits<double>::infinity()) {
+    return searches[best_worker].best_weight_;
+  }
+  for (uint32_t vertex : searches[best_worker].best_cycle_) {
+    cycle->push_back(verticies_[vertex]);
+  }
+  return searches[best_worker].best_weight_;
 }
 
-void Graph::getHamiltonianCycle(Graph::VertexData* current_hamiltonian_vertex, Graph* hamiltonian, 
-    Graph::VertexData* current_graph_vertex, Graph::VertexData* start_vertex, 
-    Graph::VertexData* hamiltonian_start) {
-  if (hamiltonian->size() == size()) {
+void Graph::extendHamiltonianPath(const HamiltonianGraph& graph, double path_weight, HamiltonianSearch* search,
+    std::atomic<double>* best_weight) {
+  search->num_explored_ += 1;
+  uint32_t last = search->path_[search->path_size_ - 1];
+  if (search->path_size_ == graph.num_verticies_) {
     // Only a hamiltonian Cycle if last vertex is adjacent to the start vertex
-    if (current_graph_vertex->isAdjacentVertex(start_vertex)) {
-      hamiltonian->insertEdge(hamiltonian_start, current_hamiltonian_vertex);
-      updateLargestHamiltonain(hamiltonian);
+    double cycle_weight = path_weight + graph.closing_weights_[last];
+    if (graph.closing_weights_[last] != -std::numeric_limits<double>::infinity()
+        && (cycle_weight > search->best_weight_
+        || (cycle_weight == search->best_weight_ && search->path_edges_ < search->best_cycle_edges_))) {
+      search->best_weight_ = cycle_weight;
+      search->best_cycle_ = search->path_;
+      search->best_cycle_edges_ = search->path_edges_;
+      double best = best_weight->load();
+      while (cycle_weight > best && !best_weight->compare_exchange_weak(best, cycle_weight)) {}
+    }
+    return;
+  }
+
+  // skip the subtree if it can't beat the largest cycle found by any thread, even if every edge left is as
+  // heavy as the heaviest edges of its verticies (with some room for rounding, so a cycle tied with the
+  // largest is still found)
+  double best = best_weight->load(std::memory_order_relaxed);
+  double weight_bound = (search->unvisited_weight_bound_ + graph.heaviest_weights_[last]
+      + graph.heaviest_weights_[graph.start_]) / 2;
+  if (path_weight + weight_bound < best - 1e-9 * std::fabs(best)) {
+    return;
+  }
+  // the same bound with only the edges the rest of the path can still use, which also finds the
+  // verticies off the path that can't be reached anymore
+  double remaining_weight_bound = boundRemainingWeight(graph, search);
+  if (remaining_weight_bound == -std::numeric_limits<double>::infinity()
+      || path_weight + remaining_weight_bound < best - 1e-9 * std::fabs(best)) {
+    return;
+  }
+
+  // the last vertex is no longer usable once the path leaves it, so a neighbor left with one usable edge
+  // has to be visited next, and one left with none can't be visited at all
+  uint32_t forced_vertex = std::numeric_limits<uint32_t>::max();
+  bool is_dead_end = false;
+  if (last != graph.start_) {
+    for (uint32_t i = graph.offsets_[last]; i < graph.offsets_[last + 1]; ++i) {
+      uint32_t other_vertex = graph.neighbors_[i];
+      search->usable_degrees_[other_vertex] -= 1;
+      if (!search->is_visited_[other_vertex] && search->usable_degrees_[other_vertex] < 2) {
+        is_dead_end = is_dead_end || search->usable_degrees_[other_vertex] == 0
+            || forced_vertex != std::numeric_limits<uint32_t>::max();
+        forced_vertex = other_vertex;
+      }
     }
   }
+
   // backtrace
-  for (Edge* edge : current_graph_vertex->adjacent_edges_) {
-    VertexData* other_vertex = edge->getOtherVertex(current_graph_vertex);
-    if (other_vertex->label_ != Graph::Label::kVisited) {
-      other_vertex->label_ = Graph::Label::kVisited;
-      hamiltonian->insertVertex(other_vertex->station_);
-      VertexData* hamiltonian_other_vertex = hamiltonian->getVertex(other_vertex->station_.id_);
-      hamiltonian->insertEdge(current_hamiltonian_vertex, hamiltonian_other_vertex);
-      getHamiltonianCycle(hamiltonian_other_vertex, hamiltonian, other_vertex, start_vertex,
-        hamiltonian_start);
-      other_vertex->label_ = Graph::Label::kUnexplored;
-      hamiltonian->removeVertex(hamiltonian_other_vertex);
+  double unvisited_weight_bound = search->unvisited_weight_bound_;
+  for (uint32_t k = graph.offsets_[last]; k < graph.offsets_[last + 1] && !is_dead_end; ++k) {
+    uint32_t i = graph.visit_order_[k];
+    uint32_t other_vertex = graph.neighbors_[i];
+    if (!search->is_visited_[other_vertex]
+        && (forced_vertex == std::numeric_limits<uint32_t>::max() || other_vertex == forced_vertex)) {
+      search->is_visited_[other_vertex] = true;
+      search->path_edges_[search->path_size_ - 1] = i;
+      search->path_[search->path_size_] = other_vertex;
+      search->path_size_ += 1;
+      search->unvisited_weight_bound_ = unvisited_weight_bound - graph.two_heaviest_weights_[other_vertex];
+      extendHamiltonianPath(graph, path_weight + graph.weights_[i], search, best_weight);
+      search->path_size_ -= 1;
+      search->is_visited_[other_vertex] = false;
+    }
+  }
+  search->unvisited_weight_bound_ = unvisited_weight_bound;
+
+  if (last != graph.start_) {
+    for (uint32_t i = graph.offsets_[last]; i < graph.offsets_[last + 1]; ++i) {
+      search->usable_degrees_[graph.neighbors_[i]] += 1;
+    }
+  }
+}
+
+double Graph::boundRemainingWeight(const HamiltonianGraph& graph, HamiltonianSearch* search) {
+  uint32_t last = search->path_[search->path_size_ - 1];
+  size_t num_unvisited = graph.num_verticies_ - search->path_size_;
+  size_t num_reached = 0;
+  bool is_start_reached = last == graph.start_;
+  // twice the bound: each vertex off the path adds its two heaviest usable edges, the ends of the path their heaviest
+  double double_bound = 0;
+  search->num_reach_checks_ += 1;
+  search->reached_by_[last] = search->num_reach_checks_;
+  search->reach_stack_.assign(1, last);
+  while (!search->reach_stack_.empty()) {
+    uint32_t vertex = search->reach_stack_.back();
+    search->reach_stack_.pop_back();
+    double heaviest = 0;
+    double second_heaviest = 0;
+    for (uint32_t i = graph.offsets_[vertex]; i < graph.offsets_[vertex + 1]; ++i) {
+      uint32_t other_vertex = graph.neighbors_[i];
+      bool is_usable = !search->is_visited_[other_vertex]
+          || (vertex != last && (other_vertex == last || other_vertex == graph.start_));
+      if (!is_usable) {
+        continue;
+      }
+      if (graph.weights_[i] > heaviest) {
+        second_heaviest = heaviest;
+        heaviest = graph.weights_[i];
+      } else if (graph.weights_[i] > second_heaviest) {
+        second_heaviest = graph.weights_[i];
+      }
+      if (search->reached_by_[other_vertex] == search->num_reach_checks_) {
+        continue;
+      }
+      // the start is the other end of the path, so the rest of the path can't go through it
+      if (other_vertex == graph.start_) {
+        search->reached_by_[other_vertex] = search->num_reach_checks_;
+        is_start_reached = true;
+      } else if (!search->is_visited_[other_vertex]) {
+        search->reached_by_[other_vertex] = search->num_reach_checks_;
+        num_reached += 1;
+        search->reach_stack_.push_back(other_vertex);
+      }
+    }
+    double_bound += vertex == last ? heaviest : heaviest + second_heaviest;
+  }
+  if (!is_start_reached || num_reached != num_unvisited) {
+    return -std::numeric_limits<double>::infinity();
+  }
+
+  // the edge back to the start comes from a vertex off the path (or from the last vertex, if the path leaves the start)
+  double heaviest = 0;
+  for (uint32_t i = graph.offsets_[graph.start_]; i < graph.offsets_[graph.start_ + 1]; ++i) {
+    if (!search->is_visited_[graph.neighbors_[i]]) {
+      heaviest = std::max(heaviest, graph.weights_[i]);
+    }
+  }
+  return (double_bound + heaviest) / 2;
+}
+
+Graph* Graph::buildCycleGraph(const std::vector<VertexData*>& cycle) {
+  Graph* cycle_graph = new Graph();
+  VertexData* cycle_start = cycle_graph->insertVertex(cycle[0]->station_);
+  VertexData* cycle_previous = cycle_start;
+  for (size_t i = 1; i < cycle.size(); ++i) {
+    VertexData* cycle_vertex = cycle_graph->insertVertex(cycle[i]->station_);
+    cycle_graph->insertEdge(cycle_previous, cycle_vertex);
+    cycle_previous = cycle_vertex;
+  }
+  cycle_graph->insertEdge(cycle_start, cycle_previous);
+  return cycle_graph;
+}
+
+Graph* Graph::getLongHamiltonianCycle(const LongCycleBudget& budget) {
+  std::vector<VertexData*> cycle;
+  findLongHamiltonianCycle(&cycle, budget);
+  if (cycle.empty()) {
+    return long_hamiltonian_;
+  }
+  Graph* hamiltonian = buildCycleGraph(cycle);
+  if (long_hamiltonian_ == nullptr || hamiltonian->getTotalDistance() > long_hamiltonian_->getTotalDistance()) {
+    delete long_hamiltonian_;
+    long_hamiltonian_ = hamiltonian;
+  } else {
+    delete hamiltonian;
+  }
+  return long_hamiltonian_;
+}
+
+double Graph::findLongHamiltonianCycle(std::vector<VertexData*>* cycle, const LongCycleBudget& budget,
+    size_t* num_restarts) const {
+  cycle->clear();
+  if (num_restarts != nullptr) {
+    *num_restarts = 0;
+  }
+  size_t num_verticies = verticies_.size();
+  if (num_verticies < 3) {
+    return -std::numeric_limits<double>::infinity();
+  }
+
+  // copy the edges into flat arrays, with each vertex's neighbors sorted for getTourEdgeWeight
+  TourGraph graph;
+  graph.num_verticies_ = num_verticies;
+  graph.offsets_.push_back(0);
+  uint32_t start = 0;
+  std::vector<uint32_t> last_seen_from(num_verticies, std::numeric_limits<uint32_t>::max());
+  std::vector<std::pair<uint32_t, double>> neighbors;
+  for (VertexData* vertex : verticies_) {
+    if (vertex->station_.id_ < verticies_[start]->station_.id_) {
+      start = vertex->index_;
+    }
+    neighbors.clear();
+    for (Edge* edge : vertex->adjacent_edges_) {
+      uint32_t other_vertex = edge->getOtherVertex(vertex)->index_;
+      if (last_seen_from[other_vertex] != vertex->index_) {
+        last_seen_from[other_vertex] = vertex->index_;
+        neighbors.push_back(std::make_pair(other_vertex, edge->getEdgeDistance()));
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    for (const std::pair<uint32_t, double>& neighbor : neighbors) {
+      graph.neighbors_.push_back(neighbor.first);
+      graph.weights_.push_back(neighbor.second);
+    }
+    graph.offsets_.push_back(static_cast<uint32_t>(graph.neighbors_.size()));
+  }
+
+  auto deadline = std::chrono::steady_clock::time_point::max();
+  if (budget.seconds_ > 0) {
+    deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(budget.seconds_));
+  }
+  size_t max_restarts = budget.num_restarts_;
+  if (max_restarts == 0 && budget.seconds_ <= 0) {
+    max_restarts = 1;
+  }
+  size_t num_threads = budget.num_threads_;
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (max_restarts != 0) {
+    num_threads = std::min(num_threads, max_restarts);
+  }
+
+  // each thread keeps the longest cycle of its restarts (ties go to the earliest restart)
+  std::atomic<size_t> next_restart(0);
+  std::atomic<size_t> num_restarts_run(0);
+  std::vector<double> worker_best_weights(num_threads, -std::numeric_limits<double>::infinity());
+  std::vector<size_t> worker_best_restarts(num_threads, 0);
+  std::vector<std::vector<uint32_t>> worker_best_tours(num_threads);
+  auto run_restarts = [&](size_t worker) {
+    std::vector<uint32_t> tour;
+    while (true) {
+      size_t restart = next_restart.fetch_add(1);
+      // the first restart always builds a tour, so there is one to return
+      if ((max_restarts != 0 && restart >= max_restarts)
+          || (restart > 0 && std::chrono::steady_clock::now() >= deadline)) {
+        return;
+      }
+      num_restarts_run += 1;
+      std::seed_seq seed = {budget.seed_, static_cast<uint32_t>(restart)};
+      std::mt19937 generator(seed);
+      uint32_t restart_start = restart == 0 ? start : static_cast<uint32_t>(generator() % num_verticies);
+      auto build_deadline = restart == 0 ? std::chrono::steady_clock::time_point::max() : deadline;
+      if (!buildTour(graph, restart_start, restart == 0, build_deadline, &generator, &tour)) {
+        continue;
+      }
+      improveTour(graph, deadline, &tour);
+
+      // rotate the cycle to start from the station with the smallest id
+      std::rotate(tour.begin(), std::find(tour.begin(), tour.end(), start), tour.end());
+      double weight = 0;
+      for (size_t i = 0; i < num_verticies; ++i) {
+        weight += getTourEdgeWeight(graph, tour[i], tour[(i + 1) % num_verticies]);
+      }
+      if (weight > worker_best_weights[worker]
+          || (weight == worker_best_weights[worker] && restart < worker_best_restarts[worker])) {
+        worker_best_weights[worker] = weight;
+        worker_best_restarts[worker] = restart;
+        worker_best_tours[worker].swap(tour);
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers.emplace_back(run_restarts, i);
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  size_t best_worker = 0;
+  for (size_t worker = 1; worker < num_threads; ++worker) {
+    if (worker_best_weights[worker] > worker_best_weights[best_worker]
+        || (worker_best_weights[worker] == worker_best_weights[best_worker]
+        && worker_best_restarts[worker] < worker_best_restarts[best_worker])) {
+      best_worker = worker;
+    }
+  }
+  if (num_restarts != nullptr) {
+    *num_restarts = num_restarts_run.load();
+  }
+  for (uint32_t vertex : worker_best_tours[best_worker]) {
+    cycle->push_back(verticies_[vertex]);
+  }
+  return worker_best_weights[best_worker];
+}
+
+double Graph::getTourEdgeWeight(const TourGraph& graph, uint32_t vertex_one, uint32_t vertex_two) {
+  auto begin = graph.neighbors_.begin() + graph.offsets_[vertex_one];
+  auto end = graph.neighbors_.begin() + graph.offsets_[vertex_one + 1];
+  auto neighbor = std::lower_bound(begin, end, vertex_two);
+  if (neighbor == end || *neighbor != vertex_two) {
+    return -std::numeric_limits<double>::infinity();
+  }
+  return graph.weights_[neighbor - graph.neighbors_.begin()];
+}
+
+bool Graph::buildTour(const TourGraph& graph, uint32_t start, bool is_greedy,
+    std::chrono::steady_clock::time_point deadline, std::mt19937* generator, std::vector<uint32_t>* tour) {
+  const uint32_t kNotOnPath = std::numeric_limits<uint32_t>::max();
+  size_t num_verticies = graph.num_verticies_;
+  std::vector<uint32_t> positions(num_verticies, kNotOnPath);
+  tour->assign(1, start);
+  positions[start] = 0;
+  // reverses the part of the path from a position to the end
+  auto reverse_from = [&](size_t first) {
+    std::reverse(tour->begin() + first, tour->end());
+    for (size_t i = first; i < tour->size(); ++i) {
+      positions[(*tour)[i]] = static_cast<uint32_t>(i);
+    }
+  };
+
+  size_t max_rotations = 50 * num_verticies;
+  size_t num_rotations = 0;
+  while (true) {
+    uint32_t end = tour->back();
+    if (tour->size() == num_verticies) {
+      if (getTourEdgeWeight(graph, end, (*tour)[0]) != -std::numeric_limits<double>::infinity()) {
+        return true;
+      }
+    } else {
+      // follow one of the heaviest edges to a vertex off the path
+      uint32_t heaviest[3] = {kNotOnPath, kNotOnPath, kNotOnPath};
+      size_t num_heaviest = 0;
+      for (uint32_t i = graph.offsets_[end]; i < graph.offsets_[end + 1]; ++i) {
+        if (positions[graph.neighbors_[i]] != kNotOnPath) {
+          continue;
+        }
+        size_t slot = num_heaviest;
+        if (num_heaviest < 3) {
+          num_heaviest += 1;
+        } else if (graph.weights_[i] > graph.weights_[heaviest[2]]) {
+          slot = 2;
+        } else {
+          continue;
+        }
+        heaviest[slot] = i;
+        for (; slot > 0 && graph.weights_[heaviest[slot]] > graph.weights_[heaviest[slot - 1]]; --slot) {
+          std::swap(heaviest[slot], heaviest[slot - 1]);
+        }
+      }
+      if (num_heaviest > 0) {
+        uint32_t next = graph.neighbors_[heaviest[is_greedy ? 0 : (*generator)() % num_heaviest]];
+        positions[next] = static_cast<uint32_t>(tour->size());
+        tour->push_back(next);
+        continue;
+      }
+    }
+
+    // rotate the path: join the end to a random vertex on the path (other than the one before it),
+    // and reverse the part of the path after that vertex, which becomes the new end
+    if (num_rotations >= max_rotations
+        || (num_rotations % 64 == 0 && std::chrono::steady_clock::now() >= deadline)) {
+      return false;
+    }
+    num_rotations += 1;
+    uint32_t pivot = kNotOnPath;
+    size_t num_pivots = 0;
+    for (uint32_t i = graph.offsets_[end]; i < graph.offsets_[end + 1]; ++i) {
+      uint32_t position = positions[graph.neighbors_[i]];
+      if (position != kNotOnPath && position + 2 < tour->size()) {
+        num_pivots += 1;
+        if ((*generator)() % num_pivots == 0) {
+          pivot = position;
+        }
+      }
+    }
+    // with no vertex to join to, continue from the other end of the path
+    reverse_from(pivot == kNotOnPath ? 0 : pivot + 1);
+  }
+}
+
+void Graph::improveTour(const TourGraph& graph, std::chrono::steady_clock::time_point deadline,
+    std::vector<uint32_t>* tour) {
+  size_t num_verticies = graph.num_verticies_;
+  if (num_verticies < 4) {
+    return;
+  }
+  std::vector<uint32_t> positions(num_verticies);
+  for (size_t i = 0; i < num_verticies; ++i) {
+    positions[(*tour)[i]] = static_cast<uint32_t>(i);
+  }
+  auto at = [&](size_t position) {
+    return (*tour)[position % num_verticies];
+  };
+  // only take moves that add more than rounding could, so the search can't go around in circles
+  auto is_improvement = [](double gain, double scale) {
+    return gain > 1e-12 * scale;
+  };
+  // checks the clock every 64 verticies of a pass
+  auto is_past_deadline = [&](size_t i) {
+    return i % 64 == 0 && std::chrono::steady_clock::now() >= deadline;
+  };
+  std::vector<uint32_t> moved_tour;
+
+  bool is_improved = true;
+  while (is_improved) {
+    is_improved = false;
+
+    // 2-opt: replace edges (a, b) and (c, d) with (a, c) and (b, d), reversing the path from b to c
+    for (size_t i = 0; i < num_verticies; ++i) {
+      if (is_past_deadline(i)) {
+        return;
+      }
+      uint32_t a = at(i);
+      uint32_t b = at(i + 1);
+      double ab_weight = getTourEdgeWeight(graph, a, b);
+      for (uint32_t k = graph.offsets_[a]; k < graph.offsets_[a + 1]; ++k) {
+        uint32_t c = graph.neighbors_[k];
+        size_t j = positions[c];
+        uint32_t d = at(j + 1);
+        if (c == b || d == a) {
+          continue;
+        }
+        double bd_weight = getTourEdgeWeight(graph, b, d);
+        if (bd_weight == -std::numeric_limits<double>::infinity()) {
+          continue;
+        }
+        double cd_weight = getTourEdgeWeight(graph, c, d);
+        if (!is_improvement(graph.weights_[k] + bd_weight - ab_weight - cd_weight, ab_weight + cd_weight)) {
+          continue;
+        }
+        size_t length = (j + num_verticies - i) % num_verticies;
+        for (size_t step = 0; step < length / 2; ++step) {
+          size_t one = (i + 1 + step) % num_verticies;
+          size_t two = (j + num_verticies - step) % num_verticies;
+          std::swap((*tour)[one], (*tour)[two]);
+          positions[(*tour)[one]] = static_cast<uint32_t>(one);
+          positions[(*tour)[two]] = static_cast<uint32_t>(two);
+        }
+        is_improved = true;
+        break;
+      }
+    }
+
+    // Or-opt: move the run from s to t (between p and q) to between x and y, the other way around if needed
+    for (size_t length = 1; length <= 3 && length + 3 <= num_verticies; ++length) {
+      for (size_t i = 0; i < num_verticies; ++i) {
+        if (is_past_deadline(i)) {
+          return;
+        }
+        uint32_t p = at(i + num_verticies - 1);
+        uint32_t s = at(i);
+        uint32_t t = at(i + length - 1);
+        uint32_t q = at(i + length);
+        double pq_weight = getTourEdgeWeight(graph, p, q);
+        if (pq_weight == -std::numeric_limits<double>::infinity()) {
+          continue;
+        }
+        double removed_weight = getTourEdgeWeight(graph, p, s) + getTourEdgeWeight(graph, t, q) - pq_weight;
+        auto is_on_run = [&](uint32_t vertex) {
+          return (positions[vertex] + num_verticies - i) % num_verticies < length;
+        };
+        for (uint32_t k = graph.offsets_[s]; k < graph.offsets_[s + 1]; ++k) {
+          uint32_t x = graph.neighbors_[k];
+          if (is_on_run(x)) {
+            continue;
+          }
+          // the run goes between x and the vertex after it (s next to x), or the vertex before it (t next to it)
+          bool is_after_x = true;
+          uint32_t y = at(positions[x] + 1);
+          double ty_weight = is_on_run(y) ? -std::numeric_limits<double>::infinity() : getTourEdgeWeight(graph, t, y);
+          double gain = graph.weights_[k] + ty_weight - getTourEdgeWeight(graph, x, y) - removed_weight;
+          if (!is_improvement(gain, removed_weight + pq_weight)) {
+            is_after_x = false;
+            y = at(positions[x] + num_verticies - 1);
+            ty_weight = is_on_run(y) ? -std::numeric_limits<double>::infinity() : getTourEdgeWeight(graph, t, y);
+            gain = graph.weights_[k] + ty_weight - getTourEdgeWeight(graph, x, y) - removed_weight;
+            if (!is_improvement(gain, removed_weight + pq_weight)) {
+              continue;
+            }
+          }
+
+          // rebuild the tour from q around to p, putting the run in next to x
+          moved_tour.clear();
+          for (size_t step = 0; step < num_verticies - length; ++step) {
+            uint32_t vertex = at(i + length + step);
+            if (vertex == x && !is_after_x) {
+              for (size_t run = length; run > 0; --run) {
+                moved_tour.push_back(at(i + run - 1));
+              }
+            }
+            moved_tour.push_back(vertex);
+            if (vertex == x && is_after_x) {
+              for (size_t run = 0; run < length; ++run) {
+                moved_tour.push_back(at(i + run));
+              }
+            }
+          }
+          tour->swap(moved_tour);
+          for (size_t position = 0; position < num_verticies; ++position) {
+            positions[(*tour)[position]] = static_cast<uint32_t>(position);
+          }
+          is_improved = true;
+          break;
+        }
+      }
     }
   }
 }
 
 Graph::VertexData* Graph::getNorthwestMost() {
-  std::map<int, VertexData*>::iterator it;
-  int latitude = -1;
-  int longitude = INT_MAX;
-  Graph::VertexData* to_return;
+  double latitude = -std::numeric_limits<double>::infinity();
+  double longitude = std::numeric_limits<double>::infinity();
+  Graph::VertexData* to_return = nullptr;
 
-  for (it = verticies_.begin(); it != verticies_.end(); it++) { //
-    Graph::Station * station = &it->second->station_;
+  // the stations are compared in order of station id
+  for (VertexData* vertex : getVerticiesById()) {
+    Graph::Station * station = &vertex->station_;
     //northwest most means that the latitude is the greatest and the longitude is the smallest
     if (station->longitude_ <= longitude && station->latitude_ >= latitude) {
       latitude = station->latitude_;
       longitude = station->longitude_;
-      to_return = it->second;
+      to_return = vertex;
     }
   }
   return to_return;
 }
 
 Graph::VertexData* Graph::getSoutheastMost() {
-  std::map<int, VertexData*>::iterator it;
-  int latitude = INT_MAX;
-  int longitude = -1;
+  double latitude = std::numeric_limits<double>::infinity();
+  double longitude = -std::numeric_limits<double>::infinity();
 
-  Graph::VertexData* to_return;
+  Graph::VertexData* to_return = nullptr;
   //southeast most means that the latitude is the smallest and the longitude is the greatest     
-  for (it = verticies_.begin(); it != verticies_.end(); it++) {
-    Graph::Station* station = &it->second->station_;
+  for (VertexData* vertex : getVerticiesById()) {
+    Graph::Station* station = &vertex->station_;
     if (station->latitude_ <= latitude && station->longitude_ >= longitude) {
       latitude = station->latitude_;
       longitude = station->longitude_;
-      to_return = it->second;
+      to_return = vertex;
     }
   }
   return to_return;
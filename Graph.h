@@ -1,16 +1,28 @@
 #pragma once
 
+#include "Arena.h"
+#include "DisjointSet.h"
+#include "VertexHeap.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <list>
 #include <limits>
 #include <map>
-#include <regex>
+#include <memory>
+#include <mutex>
+#include <random>
 #include <string>
-#include <sstream>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
-#include <boost/heap/fibonacci_heap.hpp>
+class StaticGraph;
 
 /**
  * Class representing a Graph
@@ -20,6 +32,7 @@ class Graph {
 public:
   /**
     * This enumeration stores labels for edges and verticies in the traversal
+    * (traversals keep their labels in their own arrays, so the graph isn't changed)
     * 
     * kVisited: The Vertex Has been Visited
     * kUnexplored: The edge or vertex is unexplored
@@ -28,17 +41,20 @@ public:
     */
   enum Label {kVisited, kUnexplored, kDiscovery, kBack};
 
-  struct Edge;
-  struct VertexData;
-
   /**
-   * This struct provides the comparison for the boost fibonacci heap
+   * This enumeration stores the type of user that took a trip
+   *
+   * kSubscriber: Annual Member
+   * kCustomer: 24-hour pass or 3-day pass user
+   * kUnknownUser: The data file did not give a known user type
    */
-  struct compareVertex {
-    bool operator() (VertexData* vertex_one, VertexData* vertex_two) const {
-      return vertex_one->distance_ >= vertex_two->distance_;
-    }
-  };
+  enum UserType {kSubscriber, kCustomer, kUnknownUser};
+
+  // most verticies getLargestHamiltonianCycleHeldKarp solves (its table has (n - 1) * 2^(n - 2) entries)
+  static const size_t kMaxHeldKarpVerticies = 25;
+
+  struct Edge;
+  struct VertexData;
 
   /**
    * Struct storing a Station's Data
@@ -70,21 +86,113 @@ public:
     }
 };
 
+  /**
+   * Struct storing the data of a single trip (one row of the data files) that is
+   * used to build the graph
+   */
+  struct Trip {
+    // Station the trip started from
+    Station start_station_;
+    // Station the trip ended at
+    Station end_station_;
+    // double storing the duration of the trip in seconds
+    double duration_ = 0;
+    // bool that is false if the duration could not be read (the trip is left out of the edge statistics)
+    bool has_duration_ = true;
+    // the type of user that took the trip
+    UserType user_type_ = kUnknownUser;
+  };
+
+  /**
+   * Struct storing statistics about all of the trips taken along an Edge
+   * Directions are relative to the edge: forward trips go from start_vertex_ to end_vertex_
+   */
+  struct EdgeStats {
+    // number of trips from the start vertex to the end vertex
+    size_t num_forward_trips_ = 0;
+    // number of trips from the end vertex to the start vertex
+    size_t num_backward_trips_ = 0;
+    // sum of the durations of all trips in seconds
+    double total_duration_ = 0;
+    // duration of the shortest trip in seconds
+    double min_duration_ = std::numeric_limits<double>::infinity();
+    // duration of the longest trip in seconds
+    double max_duration_ = 0;
+    // number of trips taken by subscribers
+    size_t num_subscriber_trips_ = 0;
+    // number of trips taken by customers
+    size_t num_customer_trips_ = 0;
+
+    /**
+     * Adds a trip to the statistics (trips without a duration are not added)
+     *
+     * @param trip the Trip to add
+     * @param is_forward a bool that is true if the trip went from the start vertex to the end vertex
+     */
+    void addTrip(const Trip& trip, bool is_forward);
+
+    /**
+     * Adds all trips counted in other statistics to these statistics
+     *
+     * @param other the EdgeStats to add
+     * @param is_same_direction a bool that is false if the other statistics' forward trips
+     *    are this edge's backward trips
+     */
+    void merge(const EdgeStats& other, bool is_same_direction);
+
+    /**
+     * Retrieves the number of trips in both directions
+     *
+     * @return the number of trips taken along the edge
+     */
+    size_t getNumTrips() const;
+
+    /**
+     * Retrieves the mean duration of the trips
+     *
+     * @return the mean duration of the trips in seconds (0 if there are no trips)
+     */
+    double getMeanDuration() const;
+  };
+
+  /**
+   * Struct storing statistics about reading a data file into the graph
+   */
+  struct LoadStats {
+    // string representing the path to the data file
+    std::string file_path_;
+    // bool that is true if the file could not be opened
+    bool is_missing_ = false;
+    // bool that is true if reading the file failed part way through (the rest of the file is not loaded)
+    bool has_read_error_ = false;
+    // number of rows of data read (not including the header)
+    size_t num_rows_ = 0;
+    // number of rows skipped because they did not have the correct data points
+    size_t num_rejected_rows_ = 0;
+    // number of bytes read from the file
+    size_t num_bytes_ = 0;
+    // seconds taken to read the file into the graph
+    double seconds_ = 0;
+
+    /**
+     * Retrieves the rate the file was read into the graph at
+     *
+     * @return a double representing the bytes read per second
+     */
+    double getBytesPerSecond() const;
+  };
+
   /**
    * Struct storing data for each Vertex in the Graph
    */
   struct VertexData {
     // Station storing the station that the Vertex Represents
     Station station_;
+    // dense index of the vertex in the graph (0 to size() - 1), used to index flat per-vertex arrays
+    uint32_t index_ = 0;
     // list of edges adjacent to the vertex
     std::list<Edge*> adjacent_edges_;
 
-    // Optional label for use in Graph Traversals (default is Unexplored)
-    Label label_ = kUnexplored;
-
-    // Optional double for use in Dijkstra's to track distance
-    double distance_ = std::numeric_limits<double>::infinity();
-
     /**
      * Constructor
      *
@@ -103,9 +211,6 @@ public:
      * @return bool that is true if the given vertex is adjacent to this vertex
      */
     bool isAdjacentVertex(VertexData* other_vertex) const;
-
-    // Allows for easy updates to the boost fibonacci heap
-    boost::heap::fibonacci_heap<VertexData*, boost::heap::compare<compareVertex>>::handle_type handle;
   };
 
   /**
@@ -116,9 +221,11 @@ public:
     VertexData* start_vertex_;
     // Pointer storing the ending vertex of the edge
     VertexData* end_vertex_;
+    // dense index of the edge in the graph (0 to getNumEdges() - 1), used to index flat per-edge arrays
+    uint32_t index_ = 0;
 
-    // Optional label for use in Graph Traversals (default is Unexplored)
-    Label label_ = kUnexplored;
+    // Statistics about the trips taken along the edge (empty for edges not read from data)
+    EdgeStats stats_;
 
     /**
      * Constructor
@@ -163,6 +270,176 @@ public:
     double getEdgeDistance() const;
   };
 
+  /**
+   * Weight functions that algorithms (such as Dijkstras) can be given as a template parameter
+   * to choose what the weight of an edge is
+   * Each is called as weight(edge) and returns a double
+   */
+
+  /**
+   * Weight of an edge is the distance between its stations (the default)
+   */
+  struct GeometricDistance {
+    double operator()(const Edge* edge) const {
+      return edge->getEdgeDistance();
+    }
+  };
+
+  /**
+   * Weight of an edge is the mean duration of the trips along it
+   * Edges without any trips can not be used (infinite weight)
+   */
+  struct MeanDuration {
+    double operator()(const Edge* edge) const {
+      if (edge->stats_.getNumTrips() == 0) return std::numeric_limits<double>::infinity();
+      return edge->stats_.getMeanDuration();
+    }
+  };
+
+  /**
+   * Weight of an edge is the inverse of the number of trips along it (popular edges are cheaper)
+   * Edges without any trips can not be used (infinite weight)
+   */
+  struct InversePopularity {
+    double operator()(const Edge* edge) const {
+      if (edge->stats_.getNumTrips() == 0) return std::numeric_limits<double>::infinity();
+      return 1.0 / edge->stats_.getNumTrips();
+    }
+  };
+
+  /**
+   * Heuristics that AStar can be given as a template parameter
+   * Each is called as heuristic(vertex, target) and returns a lower bound on the weight of the
+   * shortest path from the vertex to the target (it must never be more than that weight)
+   */
+
+  /**
+   * Straight line distance between the stations (the default)
+   * No path can be shorter than a straight line, so this is a lower bound for GeometricDistance
+   * weights (but not for the other weight functions)
+   */
+  struct StraightLineDistance {
+    double operator()(const VertexData* vertex, const VertexData* target) const {
+      double latitude_difference = vertex->station_.latitude_ - target->station_.latitude_;
+      double longitude_difference = vertex->station_.longitude_ - target->station_.longitude_;
+      return std::sqrt((latitude_difference * latitude_difference) + (longitude_difference * longitude_difference));
+    }
+  };
+
+  /**
+   * No heuristic (AStar searches the same verticies as Dijkstras), for any weight function
+   */
+  struct NoHeuristic {
+    double operator()(const VertexData*, const VertexData*) const {
+      return 0;
+    }
+  };
+
+  /**
+   * Class storing the result of running Dijkstras from one vertex: the distance to and the
+   * previous vertex of every vertex, in flat arrays by dense vertex index
+   * Paths are only built when asked for, and the tree is only built as a Graph (the old result of
+   * Dijkstras) if toGraph is called
+   * The tree refers to the verticies of the graph it was found in, so it can't be used after the
+   * graph changes
+   */
+  class ShortestPathTree {
+    public:
+      /**
+       * Default Constructor (an empty tree)
+       */
+      ShortestPathTree() {}
+
+      /**
+       * Retrieves the vertex the tree was grown from
+       *
+       * @return a pointer to the source vertex (nullptr for an empty tree)
+       */
+      VertexData* getSource() const;
+
+      /**
+       * Retrieves the distance from the source to a vertex
+       *
+       * @param vertex a pointer to a vertex of the graph
+       * @return the combined weight of the shortest path to the vertex (infinity if unreachable)
+       */
+      double getDistance(const VertexData* vertex) const;
+
+      /**
+       * Retrieves the vertex before a vertex on its shortest path from the source
+       *
+       * @param vertex a pointer to a vertex of the graph
+       * @return a pointer to the previous vertex (nullptr for the source and unreachable verticies)
+       */
+      VertexData* getParent(const VertexData* vertex) const;
+
+      /**
+       * Retrieves the distance to every vertex
+       *
+       * @return the distances by dense vertex index
+       */
+      const std::vector<double>& getDistances() const;
+
+      /**
+       * Retrieves the previous vertex of every vertex
+       *
+       * @return the previous verticies by dense vertex index
+       */
+      const std::vector<VertexData*>& getParents() const;
+
+      /**
+       * Builds the shortest path from the source to a vertex
+       *
+       * @param target a pointer to the vertex the path ends at
+       * @param path pointer to a vector to write the verticies of the path into, from the source
+       *    to the target (left empty if the target can't be reached)
+       * @return the combined weight of the edges of the path (infinity if there is no path)
+       */
+      double getPath(VertexData* target, std::vector<VertexData*>* path) const;
+
+      /**
+       * Builds the tree as a Graph (once; later calls return the same Graph)
+       * Verticies are inserted in the order Dijkstras settled them, each with an edge to its
+       * previous vertex, followed by the verticies that can't be reached
+       * Safe to call from several threads at once (the Graph is only built by one of them), and
+       * copies of the tree share the Graph
+       *
+       * @return a reference to the tree as a Graph
+       */
+      const Graph& toGraph() const;
+
+    private:
+      friend class Graph;
+
+      // the graph the tree was found in
+      const Graph* graph_ = nullptr;
+
+      // the vertex the tree was grown from
+      VertexData* source_ = nullptr;
+
+      // distance from the source to each vertex, by dense vertex index
+      std::vector<double> distances_;
+
+      // previous vertex on the shortest path to each vertex, by dense vertex index
+      std::vector<VertexData*> parents_;
+
+      // dense indices of the reachable verticies, in the order they were settled
+      std::vector<uint32_t> settled_order_;
+
+      /**
+       * Struct storing the tree as a Graph, built by the first call to toGraph
+       */
+      struct TreeGraph {
+        // flag set once the graph is built
+        std::once_flag is_built_;
+        // the tree as a Graph
+        std::shared_ptr<Graph> graph_;
+      };
+
+      // the tree as a Graph (shared by copies of the tree)
+      std::shared_ptr<TreeGraph> tree_graph_ = std::make_shared<TreeGraph>();
+  };
+
 
   /**
    * Default Constuctor
@@ -185,6 +462,8 @@ public:
 
   /**
    * Deletes all allocated memory
+   * Verticies are destroyed one by one (to free their adjacency lists), but edges are released
+   * along with the chunks of their arena
    */
   void destroy();
 
@@ -198,10 +477,12 @@ public:
   /**
    * Inserts a Vertex into the Graph
    * Accounts for repeated verticies
+   * The new vertex is given the next dense index (size() - 1 after inserting)
    *
    * @param station_to_add a Station to add to the graph
+   * @return a pointer to the vertex representing the station (whether it is new or already existed)
    */
-  void insertVertex(Station station_to_add);
+  VertexData* insertVertex(Station station_to_add);
 
   /**
    * Inserts an Edge into the Graph
@@ -210,31 +491,89 @@ public:
    *
    * @param vertex_one a pointer to a vertex representing the starting vertex of the edge
    * @param vertex_two a pointer to a vertex representing the ending vertex of the edge
+   * @return a pointer to the new edge (nullptr if the edge would be a self-loop)
    */
-  void insertEdge(VertexData* vertex_one, VertexData* vertex_two);
+  Edge* insertEdge(VertexData* vertex_one, VertexData* vertex_two);
 
   /**
    * Inserts an Edge into the Graph
-   * Accounts for repeated edges and self-loops (NOTE: this is time expensive)
+   * Accounts for repeated edges (using the edge index) and self-loops
    * 
    * @param vertex_one a pointer to a vertex representing the starting vertex of the edge
    * @param vertex_two a pointer to a vertex representing the ending vertex of the edge
+   * @return a pointer to the edge between the verticies, whether it is new or already existed
+   *    (nullptr if the edge would be a self-loop)
    */
-  void insertEdgeFromData(VertexData* vertex_one, VertexData* vertex_two);
+  Edge* insertEdgeFromData(VertexData* vertex_one, VertexData* vertex_two);
+
+  /**
+   * Retrieves the edge between two verticies in constant time
+   *
+   * @param vertex_one a pointer to one of the verticies of the edge
+   * @param vertex_two a pointer to the other vertex of the edge
+   * @return a pointer to the edge between the verticies (nullptr if they are not adjacent)
+   */
+  Edge* getEdge(VertexData* vertex_one, VertexData* vertex_two) const;
 
   /**
    * Removes the given vertex from the graph
+   * The last vertex (by dense index) takes the removed vertex's index so indices stay dense
    *
    * @param to_remove a vertex to remove from the graph
    */
   void removeVertex(VertexData* to_remove);
 
+  /**
+   * Inserts the stations of a trip and the edge between them into the Graph, and adds the
+   * trip to the edge's statistics
+   * Accounts for repeated verticies, repeated edges and self-loops
+   *
+   * @param trip a Trip to add to the graph
+   */
+  void insertTrip(const Trip& trip);
+
   /**
    * Adds data from the given file to the Graph
    *
    * @param file_path a string representing the path to the data file in relation to the .cpp file
+   * @return LoadStats describing how the file was read
    */
-  void addDataFromFile(std::string file_path);
+  LoadStats addDataFromFile(std::string file_path);
+
+  /**
+   * Adds data from the given file to the Graph by memory mapping the file and reading
+   * rows directly from the mapping (reaches the same graph as addDataFromFile)
+   * Falls back to buffered reads if the file can't be mapped (for example, a pipe)
+   *
+   * @param file_path a string representing the path to the data file in relation to the .cpp file
+   * @return LoadStats describing how the file was read
+   */
+  LoadStats addDataFromMappedFile(std::string file_path);
+
+  /**
+   * Adds data from the given file to the Graph, parsing the file on multiple threads
+   * The file is split into chunks of whole rows, each thread parses a chunk into its own
+   * list of trips, and the lists are merged into the graph in file order (so the graph is
+   * the same as the one built by addDataFromFile)
+   *
+   * @param file_path a string representing the path to the data file in relation to the .cpp file
+   * @param num_threads the number of threads to parse the file with (0 uses one thread per core)
+   * @return LoadStats describing how the file was read
+   */
+  LoadStats addDataFromFile(std::string file_path, size_t num_threads);
+
+  /**
+   * Adds data from each of the given files to the Graph, reading and parsing files concurrently
+   * Worker threads each read and parse a whole file while the calling thread merges parsed
+   * files into the graph in the order given (so the graph is the same as calling
+   * addDataFromFile on each file in order)
+   * At most num_threads parsed files wait to be merged at a time, which bounds memory use
+   *
+   * @param file_paths a vector of strings representing the paths to the data files
+   * @param num_threads the number of files to read at once (0 uses one thread per core)
+   * @return a LoadStats for each file (in the same order as file_paths)
+   */
+  std::vector<LoadStats> addDataFromFiles(const std::vector<std::string>& file_paths, size_t num_threads);
 
   /**
    * Retrives the vertex representing the station with the given station id
@@ -244,13 +583,38 @@ public:
    */
   VertexData* getVertex(int station_id);
 
+  /**
+   * Retrives the vertex with the given dense index
+   *
+   * @param index the dense index of the vertex (less than size())
+   * @return a pointer to the vertex with the given index
+   */
+  VertexData* getVertexByIndex(uint32_t index) const;
+
   /**
    * Retrieves the vertex map of the graph
+   * Builds the map from the dense vertex list, so prefer getVertexList() or getVertex()
+   * when the verticies don't need to be in order of station id
    * 
    * @return a map representing the vertex map of the graph (Key: station id, Value: Vertex of station with the given key's id)
    */
   std::map<int, VertexData*> getVertexMap() const;
 
+  /**
+   * Retrieves the verticies of the graph in order of dense index
+   *
+   * @return a reference to the vector of verticies (the vertex at position i has index_ i)
+   */
+  const std::vector<VertexData*>& getVertexList() const;
+
+  /**
+   * Retrieves the verticies of the graph in order of station id
+   * Sorts a copy of the vertex list, which is cheaper than building getVertexMap()
+   *
+   * @return a vector of the verticies sorted by station id
+   */
+  std::vector<VertexData*> getVerticiesById() const;
+
   /**
    * Retrives the edge list of the graph
    *
@@ -258,6 +622,13 @@ public:
    */
   std::list<Edge*> getEdgeList() const;
 
+  /**
+   * Retrieves the number of edges in the graph
+   *
+   * @return the number of edges (one more than the largest dense edge index)
+   */
+  size_t getNumEdges() const;
+
   /**
    * Retrives the combined distance of all edges in the graph
    *
@@ -266,65 +637,299 @@ public:
   double getTotalDistance() const;
 
   /**
-   * Determines if graph is connected
+   * Builds a frozen copy of the Graph in compressed sparse row form (see StaticGraph), with the
+   * distance between stations as edge weights
+   * Use the StaticGraph constructor directly for other weight functions
+   *
+   * @return a StaticGraph with the same verticies and edges as the Graph
+   */
+  StaticGraph freeze() const;
+
+  /**
+   * Saves the Graph to a binary snapshot file (see Snapshot), which stores the stations, the
+   * compressed sparse row adjacency with the distance between stations as edge weights, and
+   * every edge with its trip statistics
+   *
+   * @param file_path a string representing the path to save the snapshot to
+   * @param source_file_paths the paths to the data files the Graph was built from, stored with
+   *    their sizes and modification times so a stale snapshot can be found (see Snapshot::isBuiltFrom)
+   * @return true if the snapshot was saved
+   */
+  bool saveSnapshot(const std::string& file_path,
+      const std::vector<std::string>& source_file_paths = std::vector<std::string>()) const;
+
+  /**
+   * Adds the stations and edges (with their trip statistics) of a snapshot file to the Graph
+   * The file is memory mapped and read in place, so no text is parsed
+   * Loading a snapshot into an empty graph gives the same graph that was saved (with the
+   * same edges in the same order)
+   * To use the snapshot's adjacency without building a Graph, see StaticGraph::loadSnapshot
+   *
+   * @param file_path a string representing the path to the snapshot
+   * @return true if the snapshot was loaded (false if it is missing, from another version, or
+   *    corrupt, in which case the Graph is unchanged)
+   */
+  bool loadSnapshot(const std::string& file_path);
+
+  /**
+   * Determines if graph is connected (read from the connected components, which are kept up to
+   * date as edges are added)
    *
    * @return true if the graph is connected, false otherwise
    */
-  bool isConnected();
+  bool isConnected() const;
+
+  /**
+   * Retrieves the number of connected components of the graph
+   *
+   * @return the number of connected components (0 for a graph with no verticies)
+   */
+  size_t getNumConnectedComponents() const;
+
+  /**
+   * Finds the connected component of a station
+   * Takes constant time after loading data (and a few steps after inserting edges one at a time)
+   *
+   * @param station a pointer to the vertex of the station
+   * @return the id of the station's component (the dense index of one of the verticies in it), which
+   *    is the same for every station in the component until an edge or vertex is added or removed
+   */
+  uint32_t getComponent(VertexData* station) const;
 
   /**
    * Determines if the graph is not Eulerian, or if the graph has a Eulerian path or cycle
    *
    * @return 0 if not Eulerian, 1 if has a Eulerian path, 2 if has a Eulerian cycle
    */
-  int isEulerian(); 
+  int isEulerian() const;
 
   /**
-   * Finds the minimum spanning tree of the Graph using Dijkstras Algorithm
+   * Finds the shortest path tree of the Graph using Dijkstras Algorithm
    *
+   * @tparam WeightFunction the weight function used for edges (GeometricDistance,
+   *    MeanDuration, InversePopularity, or any type with double operator()(const Edge*))
+   * @tparam Heap the priority queue of verticies (DaryHeap, LazyBinaryHeap or FibonacciHeap,
+   *    see VertexHeap.h); verticies are added to it as they are discovered
    * @param starting_vertex a pointer to the vertex to start Dijkstra's from
-   * @return a pair representing the result of running Dijkstras strom the provided starting
-   *    vertex
-   *    first: a Graph representing the DAG vertex produced by running Dijkstras on the Graph
-           from the provided starting vertex
-   *    second: a map representing the previous vertex map produced by running Dijkstras on
-   *        the Graph
-   *        Key: int representing the station id of the vertex to find the previous vertex of
-   *        Value: Pointer to the vertex that occurs prior to the given vertex in the MST produced
-   *            by running Dijkstras on the Graph
+   * @param weight the weight function to use for edges
+   * @return a ShortestPathTree storing the distance to and previous vertex of every vertex
+   *    (call toGraph on it for the tree as a Graph)
    */
-  std::pair<Graph, std::map<int, VertexData*>> Dijkstras(VertexData* starting_vertex);
+  template <typename WeightFunction = GeometricDistance, typename Heap = DaryHeap<4>>
+  ShortestPathTree Dijkstras(VertexData* starting_vertex, WeightFunction weight = WeightFunction()) const;
+
+  /**
+   * Finds the shortest distance from a vertex to every vertex using Dijkstras Algorithm, without
+   * building a minimum spanning tree
+   *
+   * @tparam WeightFunction the weight function used for edges (see Dijkstras above)
+   * @tparam Heap the priority queue of verticies (see Dijkstras above)
+   * @param starting_vertex a pointer to the vertex to start Dijkstra's from
+   * @param distances pointer to a vector to write the distance to each vertex into, by dense
+   *    vertex index (infinity if unreachable)
+   * @param previous_verticies pointer to a vector to write the previous vertex on the shortest
+   *    path to each vertex into, by dense vertex index (nullptr for the start and unreachable
+   *    verticies); may be nullptr
+   * @param weight the weight function to use for edges
+   */
+  template <typename WeightFunction = GeometricDistance, typename Heap = DaryHeap<4>>
+  void Dijkstras(VertexData* starting_vertex, std::vector<double>* distances,
+      std::vector<VertexData*>* previous_verticies, WeightFunction weight = WeightFunction()) const;
+
+  /**
+   * Finds the shortest path between two verticies using Dijkstras Algorithm
+   * Stops as soon as the target's distance is final, and builds neither a minimum spanning
+   * tree nor a map of previous verticies
+   *
+   * @tparam WeightFunction the weight function used for edges (see Dijkstras)
+   * @tparam Heap the priority queue of verticies (see Dijkstras)
+   * @param source a pointer to the vertex the path starts at
+   * @param target a pointer to the vertex the path ends at
+   * @param path pointer to a vector to write the verticies of the path into, from source to
+   *    target (its memory is reused, so a caller can pass the same vector to many queries);
+   *    left empty if there is no path
+   * @param weight the weight function to use for edges
+   * @return the combined weight of the edges of the path (infinity if there is no path)
+   */
+  template <typename WeightFunction = GeometricDistance, typename Heap = DaryHeap<4>>
+  double shortestPath(VertexData* source, VertexData* target, std::vector<VertexData*>* path,
+      WeightFunction weight = WeightFunction()) const;
+
+  /**
+   * Finds the shortest path between two verticies with a bidirectional Dijkstras search
+   * One search runs forward from the source and one runs backward from the target (always
+   * advancing the search whose next vertex is closer), and they stop once the sum of their next
+   * distances is at least the shortest path found between them, so each search only covers
+   * about half of the distance
+   * Gives the same cost as shortestPath (and the same path, unless there are several shortest paths)
+   *
+   * @tparam WeightFunction the weight function used for edges (see Dijkstras)
+   * @tparam Heap the priority queue of verticies (see Dijkstras)
+   * @param source a pointer to the vertex the path starts at
+   * @param target a pointer to the vertex the path ends at
+   * @param path pointer to a vector to write the verticies of the path into (see shortestPath)
+   * @param weight the weight function to use for edges
+   * @return the combined weight of the edges of the path (infinity if there is no path)
+   */
+  template <typename WeightFunction = GeometricDistance, typename Heap = DaryHeap<4>>
+  double bidirectionalShortestPath(VertexData* source, VertexData* target, std::vector<VertexData*>* path,
+      WeightFunction weight = WeightFunction()) const;
+
+  /**
+   * Finds the shortest path between two verticies using the A* search algorithm
+   * Verticies are searched in order of their distance from the source plus the heuristic's lower
+   * bound on their distance to the target, so the search heads towards the target instead of
+   * spreading out evenly like Dijkstras
+   * Gives the same cost as shortestPath when the heuristic is a lower bound for the weight function
+   *
+   * @tparam Heuristic the lower bound on the distance to the target (StraightLineDistance,
+   *    NoHeuristic, or any type with double operator()(const VertexData*, const VertexData*))
+   * @tparam WeightFunction the weight function used for edges (see Dijkstras)
+   * @tparam Heap the priority queue of verticies (see Dijkstras)
+   * @param source a pointer to the vertex the path starts at
+   * @param target a pointer to the vertex the path ends at
+   * @param path pointer to a vector to write the verticies of the path into (see shortestPath)
+   * @param num_settled pointer to write the number of verticies the search settled (popped)
+   *    into, including the target (may be nullptr)
+   * @param heuristic the heuristic to use
+   * @param weight the weight function to use for edges
+   * @return the combined weight of the edges of the path (infinity if there is no path)
+   */
+  template <typename Heuristic = StraightLineDistance, typename WeightFunction = GeometricDistance,
+      typename Heap = DaryHeap<4>>
+  double AStar(VertexData* source, VertexData* target, std::vector<VertexData*>* path, size_t* num_settled,
+      Heuristic heuristic = Heuristic(), WeightFunction weight = WeightFunction()) const;
+
+  /**
+   * Finds the shortest distance from each source to each target, running one Dijkstras per source
+   * on a pool of threads
+   * Each thread keeps its own distances and heap (reused for each of its searches), and nothing in
+   * the graph is changed, so the searches run at the same time; a search stops once every target
+   * is settled
+   *
+   * @tparam WeightFunction the weight function used for edges (see Dijkstras)
+   * @tparam Heap the priority queue of verticies (see Dijkstras)
+   * @param sources the verticies to find the distances from
+   * @param targets the verticies to find the distances to
+   * @param num_threads the number of threads to search with (0 for one per core)
+   * @param weight the weight function to use for edges
+   * @return the distances in row-major order: the distance from sources[i] to targets[j] is at
+   *    i * targets.size() + j (infinity if the target can't be reached)
+   */
+  template <typename WeightFunction = GeometricDistance, typename Heap = DaryHeap<4>>
+  std::vector<double> distanceMatrix(const std::vector<VertexData*>& sources, const std::vector<VertexData*>& targets,
+      size_t num_threads = 0, WeightFunction weight = WeightFunction()) const;
+
+  /**
+   * Finds the largest (most weight covered) hamiltonian cycle with the Held-Karp dynamic program
+   * (taking the largest path instead of the smallest), for graphs of up to kMaxHeldKarpVerticies
+   * verticies, such as the stations of one neighborhood
+   * The cycle starts at the station with the smallest id. For each set S of the other verticies and
+   * each vertex v in S, the table stores the largest weight of a path from the start through every
+   * vertex of S that ends at v; sets are filled in order of size, and each size is split between
+   * the same threads, which wait for each other before the next size (only the sets of the current
+   * size are visited, in order with Gosper's hack). The cycle is then traced back through the
+   * table, so no parent table is stored
+   * The table takes (n - 1) * 2^(n - 2) doubles: 80 MB for 20 verticies, 1.5 GB for 25
+   *
+   * @tparam WeightFunction the weight function used for edges (see Dijkstras); edges with infinite
+   *    weight can't be used
+   * @param cycle pointer to a vector to write the verticies of the cycle into, in order from the
+   *    start (the cycle returns to the start from the last vertex); left empty if there is no cycle
+   * @param num_threads the number of threads to fill the table with (0 for one per core)
+   * @param weight the weight function to use for edges
+   * @return the combined weight of the edges of the cycle (negative infinity if there is no
+   *    hamiltonian cycle, or the graph has more than kMaxHeldKarpVerticies verticies)
+   */
+  template <typename WeightFunction = GeometricDistance>
+  double getLargestHamiltonianCycleHeldKarp(std::vector<VertexData*>* cycle, size_t num_threads = 0,
+      WeightFunction weight = WeightFunction()) const;
 
   /**
    * Find the largest (most distance covered) hamiltonian cycle in the graph
+   * (see findLargestHamiltonianCycle); the result is kept in the graph (so it is freed with the graph)
    *
-   * @return a Graph representing the largest Hamiltonian Cycle in the graph
+   * @param num_threads the number of threads to search with (0 for one per core)
+   * @return a Graph representing the largest Hamiltonian Cycle in the graph (nullptr if there is none)
    */
-  Graph* getLargestHamiltonianCycle();
+  Graph* getLargestHamiltonianCycle(size_t num_threads = 0);
 
   /**
-   * Updates the Largest Hamiltonian Cycle if the given graph is larger (covers
-   * more distance)
+   * Finds the largest (most distance covered) hamiltonian cycle with a parallel branch and bound
+   * search, starting from the station with the smallest id
+   * The search tree is split into subtrees at a shallow depth (the paths of the first few
+   * verticies), which are dealt out to the threads in order; a thread that runs out of subtrees
+   * steals the last one of another thread. Each thread keeps its own path and visited flags, and
+   * the threads share the weight of the largest cycle found so far
+   * A path isn't extended when:
+   *  - it can't beat the largest cycle found so far, even if each edge left were as heavy as the
+   *    heaviest edges of its verticies (each vertex off the path adds half of its two heaviest
+   *    edges, the two ends of the path half of their heaviest edge)
+   *  - a vertex off the path is left with fewer than two edges to verticies off the path or to
+   *    the ends of the path (a vertex left with one such edge must be visited next)
+   *  - the verticies off the path can't all be reached from the end of the path without going
+   *    through the path
+   * The search tries the heaviest edges first, but ties go to the cycle that comes first in the
+   * order of the adjacency lists, so every number of threads gives the same cycle
    *
-   * @param to_check Graph* to check if it is larger than the current largest
-   *    Hamiltonian Cycle
+   * @param cycle pointer to a vector to write the verticies of the cycle into, in order from the
+   *    start (the cycle returns to the start from the last vertex); left empty if there is no cycle
+   * @param num_threads the number of threads to search with (0 for one per core)
+   * @param num_explored pointer to write the number of paths the search looked at into (may be nullptr)
+   * @return the combined distance of the edges of the cycle (negative infinity if there is no
+   *    hamiltonian cycle)
    */
-  void updateLargestHamiltonain(Graph* to_check);
-  
+  double findLargestHamiltonianCycle(std::vector<VertexData*>* cycle, size_t num_threads = 0,
+      size_t* num_explored = nullptr) const;
+
   /**
-   * Helper Function for Largest Hamiltonian Cycle 
-   * 
-   * @param current_hamiltonian_vertex a VertexData* representing the current vertex in
-   *    the hamiltonian cycle
-   * @param hamiltonian a Graph storing the hamiltonian cycle
-   * @param current_graph_vertex a VertexData* representing the current vertex in the graph
-   * @param start_vertex a VertexData* representing the starting vertex in the graph
-   * @param hamiltonian_start a VertexData* representing the starting vertex in the 
-   *    hamiltonian cycle
+   * Struct storing how long findLongHamiltonianCycle may search for
+   */
+  struct LongCycleBudget {
+    /**
+     * Default Constructor (one second, on one thread per core)
+     */
+    LongCycleBudget() : seconds_(1), num_restarts_(0), num_threads_(0), seed_(0) {}
+
+    // most seconds to search for (0 for no limit)
+    double seconds_;
+    // most restarts to run (0 for no limit); if neither limit is set one restart is run
+    size_t num_restarts_;
+    // number of threads to run restarts on (0 for one per core)
+    size_t num_threads_;
+    // seed of the random choices of the restarts
+    uint32_t seed_;
+  };
+
+  /**
+   * Find a long (but not necessarily the largest) hamiltonian cycle in the graph within a budget
+   * (see findLongHamiltonianCycle); the result is kept in the graph (so it is freed with the graph),
+   * unless an earlier call found a longer cycle
+   *
+   * @param budget the LongCycleBudget limiting the search
+   * @return a Graph representing the longest Hamiltonian Cycle found (nullptr if none was found)
+   */
+  Graph* getLongHamiltonianCycle(const LongCycleBudget& budget = LongCycleBudget());
+
+  /**
+   * Finds a long hamiltonian cycle (of at least three verticies) for graphs too large for the exact search
+   * Each restart builds a tour greedily: the path follows the heaviest edge to a vertex it hasn't
+   * visited (one of the three heaviest at random, after the first restart), and when it gets stuck
+   * (or can't close the cycle) it is rotated: the end is joined to a vertex on the path and the part
+   * of the path after that vertex is reversed. The tour is then improved with 2-opt moves
+   * (replacing two edges with the two edges that reconnect the tour the other way) and Or-opt moves
+   * (moving a run of one to three verticies elsewhere) until no move makes it longer; moves only
+   * use edges of the graph. Restarts run in parallel until the budget runs out
+   * With only a restart budget the result is the same for every number of threads
+   *
+   * @param cycle pointer to a vector to write the verticies of the cycle into, in order from the
+   *    station with the smallest id; left empty if no cycle was found
+   * @param budget the LongCycleBudget limiting the search
+   * @param num_restarts pointer to write the number of restarts run into (may be nullptr)
+   * @return the combined distance of the edges of the cycle (negative infinity if none was found)
    */
-  void getHamiltonianCycle(Graph::VertexData* current_hamiltonian_vertex, Graph* hamiltonian, 
-      Graph::VertexData* current_graph_vertex, Graph::VertexData* start_vertex,
-      Graph::VertexData* hamiltonian_start);
+  double findLongHamiltonianCycle(std::vector<VertexData*>* cycle, const LongCycleBudget& budget,
+      size_t* num_restarts = nullptr) const;
 
   /**
    * Retrieves the number of verticies in the graph
@@ -350,20 +955,287 @@ public:
 
 private:
   /**
-   * A map representing the verticies in the graph
+   * Adds each row of data in the given characters to the Graph
+   *
+   * @param begin pointer to the first character to read
+   * @param end pointer to one past the last character to read
+   * @param is_end_of_data a bool that is true if there is no more data after end (if false,
+   *    a row that is not ended by a newline is left unread)
+   * @param is_first_line pointer to a bool that is true if the next row is the header
+   * @param stats pointer to the LoadStats to count rows in
+   * @return pointer to the first character that was not read
+   */
+  const char* addDataFromRows(const char* begin, const char* end, bool is_end_of_data,
+      bool* is_first_line, LoadStats* stats);
+
+  /**
+   * Struct storing all of the trips between one pair of stations in part of a data file
+   */
+  struct TripSummary {
+    // the first trip between the stations (its stations are the ones added to the graph)
+    Trip first_trip_;
+    // statistics of all the trips (forward trips go in the same direction as the first trip)
+    EdgeStats stats_;
+  };
+
+  /**
+   * Parses each row of data in the given characters into one TripSummary per pair of stations,
+   * in the order each pair first appears (later trips between the stations would only change
+   * the edge's statistics)
+   * Does not modify a Graph, so chunks of a file can be parsed on separate threads
+   *
+   * @param begin pointer to the first character of the first row to parse
+   * @param end pointer to one past the last character of the last row to parse
+   * @param summaries pointer to the list to add the summaries to
+   * @param stats pointer to the LoadStats to count rows in
+   */
+  static void parseTripSummaries(const char* begin, const char* end, std::vector<TripSummary>* summaries,
+      LoadStats* stats);
+
+  /**
+   * Inserts the stations and edge of a summary of trips into the Graph, and adds the summary's
+   * statistics to the edge
+   *
+   * @param summary the TripSummary to add to the graph
+   */
+  void insertTripSummary(const TripSummary& summary);
+
+  /**
+   * Reads and parses a whole data file into a list of trip summaries (see parseTripSummaries)
+   *
+   * @param file_path a string representing the path to the data file
+   * @param summaries pointer to the list to add the summaries to
+   * @return LoadStats describing how the file was read
+   */
+  static LoadStats parseTripSummariesFromFile(const std::string& file_path,
+      std::vector<TripSummary>* summaries);
+
+  /**
+   * Runs Dijkstras from a vertex into flat arrays (shared by both versions of Dijkstras)
+   *
+   * @tparam WeightFunction the weight function used for edges (see Dijkstras)
+   * @tparam Heap the priority queue of verticies (see Dijkstras)
+   * @param starting_vertex a pointer to the vertex to start Dijkstra's from
+   * @param distances pointer to a vector to write the distance to each vertex into, by index
+   * @param previous_verticies pointer to a vector to write the previous vertex of each vertex
+   *    into, by index (may be nullptr)
+   * @param settled_order pointer to a vector to write the indices of the reachable verticies into,
+   *    in the order they were settled (may be nullptr)
+   * @param weight the weight function to use for edges
+   */
+  template <typename WeightFunction, typename Heap>
+  void searchShortestPaths(VertexData* starting_vertex, std::vector<double>* distances,
+      std::vector<VertexData*>* previous_verticies, std::vector<uint32_t>* settled_order,
+      WeightFunction weight) const;
+
+  /**
+   * Struct storing the graph in flat arrays for the hamiltonian cycle search (shared by its threads)
+   */
+  struct HamiltonianGraph {
+    // number of verticies
+    size_t num_verticies_ = 0;
+    // dense index of the vertex the cycles start from
+    uint32_t start_ = 0;
+    // index of the first neighbor of each vertex (with one extra entry at the end)
+    std::vector<uint32_t> offsets_;
+    // neighbors of every vertex (in the order of its adjacency list, without repeats)
+    std::vector<uint32_t> neighbors_;
+    // distance of the edge to each neighbor
+    std::vector<double> weights_;
+    // indices into neighbors_ of each vertex's neighbors, heaviest edge first (the order the search
+    // tries them in, so it finds heavy cycles early and can prune more)
+    std::vector<uint32_t> visit_order_;
+    // distance of the edge from each vertex back to the start (negative infinity if none)
+    std::vector<double> closing_weights_;
+    // distance of the heaviest edge of each vertex
+    std::vector<double> heaviest_weights_;
+    // combined distance of the two heaviest edges of each vertex (twice the heaviest if it has one neighbor)
+    std::vector<double> two_heaviest_weights_;
+  };
+
+  /**
+   * Struct storing the state of one thread of the hamiltonian cycle search, so the search
+   * doesn't label the verticies of the graph
+   */
+  struct HamiltonianSearch {
+    // verticies of the current path, from the start (sized to every vertex once, only the first
+    // path_size_ are on the path)
+    std::vector<uint32_t> path_;
+    // indices into neighbors_ of the edges of the current path (path_edges_[i] joins path_[i] and
+    // path_[i + 1], which orders the paths in the adjacency lists)
+    std::vector<uint32_t> path_edges_;
+    // number of verticies on the current path
+    size_t path_size_ = 0;
+    // whether each vertex is on the current path, by dense vertex index
+    std::vector<bool> is_visited_;
+    // number of neighbors of each vertex that are off the path or at its ends
+    std::vector<uint32_t> usable_degrees_;
+    // combined two_heaviest_weights_ of the verticies off the path
+    double unvisited_weight_bound_;
+    // the last search that reached each vertex while checking that the verticies off the path are connected
+    std::vector<size_t> reached_by_;
+    // number of connectivity checks run so far
+    size_t num_reach_checks_ = 0;
+    // verticies left to look at in the connectivity check
+    std::vector<uint32_t> reach_stack_;
+    // number of paths looked at
+    size_t num_explored_ = 0;
+    // distance of the largest cycle the thread has found (negative infinity if none)
+    double best_weight_ = -std::numeric_limits<double>::infinity();
+    // verticies of the largest cycle the thread has found (ties go to the cycle with the smallest
+    // path_edges_, the one a single thread would have kept)
+    std::vector<uint32_t> best_cycle_;
+    // path_edges_ of the largest cycle the thread has found
+    std::vector<uint32_t> best_cycle_edges_;
+  };
+
+  /**
+   * Searches every extension of a thread's path for hamiltonian cycles
+   *
+   * @param graph the HamiltonianGraph to search
+   * @param path_weight the distance of the thread's path
+   * @param search the HamiltonianSearch of the thread (its path is the same when this returns)
+   * @param best_weight the distance of the largest cycle any thread has found
+   */
+  static void extendHamiltonianPath(const HamiltonianGraph& graph, double path_weight, HamiltonianSearch* search,
+      std::atomic<double>* best_weight);
+
+  /**
+   * Finds an upper bound on the combined distance of the edges left to close a thread's path into
+   * a hamiltonian cycle: half of the two heaviest edges of each vertex off the path and the heaviest
+   * edge of each end of the path, counting only edges the rest of the cycle can still use
+   *
+   * @param graph the HamiltonianGraph being searched
+   * @param search the HamiltonianSearch of the thread
+   * @return the bound (negative infinity if a vertex off the path, or the start, can't be reached from
+   *    the end of the path without going through the path)
+   */
+  static double boundRemainingWeight(const HamiltonianGraph& graph, HamiltonianSearch* search);
+
+  /**
+   * Builds a Graph of a cycle (the verticies in order, and an edge back to the first)
+   *
+   * @param cycle the verticies of the cycle
+   * @return a pointer to the new Graph (the caller deletes it)
+   */
+  static Graph* buildCycleGraph(const std::vector<VertexData*>& cycle);
+
+  /**
+   * Struct storing the graph in flat arrays for the long hamiltonian cycle heuristic
+   */
+  struct TourGraph {
+    // number of verticies
+    size_t num_verticies_ = 0;
+    // index of the first neighbor of each vertex (with one extra entry at the end)
+    std::vector<uint32_t> offsets_;
+    // neighbors of every vertex (sorted by dense index, without repeats)
+    std::vector<uint32_t> neighbors_;
+    // distance of the edge to each neighbor
+    std::vector<double> weights_;
+  };
+
+  /**
+   * Finds the distance of the edge between two verticies of a TourGraph (a binary search of the
+   * neighbors of the first)
+   *
+   * @param graph the TourGraph
+   * @param vertex_one the dense index of one vertex
+   * @param vertex_two the dense index of the other vertex
+   * @return the distance of the edge (negative infinity if there is no edge)
+   */
+  static double getTourEdgeWeight(const TourGraph& graph, uint32_t vertex_one, uint32_t vertex_two);
+
+  /**
+   * Builds a hamiltonian cycle greedily, rotating the path when it gets stuck (see findLongHamiltonianCycle)
+   *
+   * @param graph the TourGraph
+   * @param start the dense index of the vertex the path starts from
+   * @param is_greedy whether to always follow the heaviest edge (instead of one of the three heaviest)
+   * @param deadline the time to give up at (checked every few rotations)
+   * @param generator the random number generator of the restart
+   * @param tour pointer to a vector to write the verticies of the cycle into
+   * @return true if a cycle was found before running out of rotations or time
+   */
+  static bool buildTour(const TourGraph& graph, uint32_t start, bool is_greedy,
+      std::chrono::steady_clock::time_point deadline, std::mt19937* generator, std::vector<uint32_t>* tour);
+
+  /**
+   * Improves a hamiltonian cycle with 2-opt and Or-opt moves until no move makes it longer
+   *
+   * @param graph the TourGraph
+   * @param deadline the time to stop improving at (checked every few moves)
+   * @param tour pointer to the verticies of the cycle, which are reordered in place
+   */
+  static void improveTour(const TourGraph& graph, std::chrono::steady_clock::time_point deadline,
+      std::vector<uint32_t>* tour);
+
+  /**
+   * Writes the verticies of a path found by a search into a vector, from the source to the target
+   *
+   * @param source a pointer to the vertex the search started from
+   * @param target a pointer to the vertex the path ends at (must have been reached by the search)
+   * @param previous_verticies the previous vertex of each vertex the search reached, by index
+   * @param path pointer to the vector to write the verticies of the path into
+   */
+  static void buildPath(VertexData* source, VertexData* target, const std::vector<VertexData*>& previous_verticies,
+      std::vector<VertexData*>* path);
+
+  /**
+   * Builds the connected components again from every edge (after a vertex is removed, since a
+   * disjoint set can't split a component)
+   */
+  void rebuildComponents();
+
+  /**
+   * Creates a key for an unordered pair of stations
+   *
+   * @param station_one_id the id of one of the stations
+   * @param station_two_id the id of the other station
+   * @return a key that is the same for both orders of the stations
+   */
+  static uint64_t getStationPairKey(int station_one_id, int station_two_id);
+
+  /**
+   * Verticies in the graph, indexed by their dense index
+   */
+  std::vector<VertexData*> verticies_;
+
+  /**
+   * Translates external station ids into dense vertex indices
    * Key: int representing a station id
-   * Value: Vertex corresponding to the station with the given station id
+   * Value: dense index of the vertex corresponding to the station with the given station id
    */
-  std::map<int, VertexData*> verticies_;
+  std::unordered_map<int, uint32_t> station_indices_;
 
   /**
-   * List of Pointers to all the edges in the graph
+   * Pointers to all the edges in the graph, by dense edge index
    */
-  std::list<Edge*> edges_;
+  std::vector<Edge*> edges_;
+
+  /**
+   * Index of the edges in the graph, used to find duplicate edges without walking adjacency lists
+   * Key: unordered pair of the station ids of the edge's verticies (see getStationPairKey)
+   * Value: Pointer to the edge between the verticies
+   */
+  std::unordered_map<uint64_t, Edge*> edge_index_;
+
+  // connected components of the graph, as a disjoint set of the dense vertex indices (joined by every edge inserted)
+  DisjointSet components_;
+
+  // arena that the verticies of the graph are allocated from
+  Arena<VertexData> vertex_arena_;
+
+  // arena that the edges of the graph are allocated from
+  Arena<Edge> edge_arena_;
 
   // Graph to store the largest hamiltonian cycle in the graph
   Graph* largest_hamiltonian_ = nullptr;
 
+  // Graph to store the longest hamiltonian cycle found by getLongHamiltonianCycle
+  Graph* long_hamiltonian_ = nullptr;
+
   // variable to keep track of the total distance (weight of all graph edges combined)
   double total_distance_ = 0;
 };
+
+#include "Graph.hpp"
@@ -0,0 +1,522 @@
+/**
+ * Definitions of the Graph's template member functions
+ * (included at the bottom of Graph.h)
+ */
+
+template <typename WeightFunction, typename Heap>
+Graph::ShortestPathTree Graph::Dijkstras(Graph::VertexData* starting_vertex, WeightFunction weight) const {
+  ShortestPathTree tree;
+  tree.graph_ = this;
+  tree.source_ = starting_vertex;
+  searchShortestPaths<WeightFunction, Heap>(starting_vertex, &tree.distances_, &tree.parents_, &tree.settled_order_,
+      weight);
+  return tree;
+}
+
+template <typename WeightFunction, typename Heap>
+void Graph::Dijkstras(Graph::VertexData* starting_vertex, std::vector<double>* distances,
+    std::vector<Graph::VertexData*>* previous_verticies, WeightFunction weight) const {
+  searchShortestPaths<WeightFunction, Heap>(starting_vertex, distances, previous_verticies, nullptr, weight);
+}
+
+template <typename WeightFunction, typename Heap>
+void Graph::searchShortestPaths(Graph::VertexData* starting_vertex, std::vector<double>* distances,
+    std::vector<Graph::VertexData*>* previous_verticies, std::vector<uint32_t>* settled_order,
+    WeightFunction weight) const {
+  // per-vertex state lives in flat vectors indexed by dense vertex index
+  distances->assign(verticies_.size(), std::numeric_limits<double>::infinity());
+  if (previous_verticies != nullptr) {
+    previous_verticies->assign(verticies_.size(), nullptr);
+  }
+  if (settled_order != nullptr) {
+    settled_order->clear();
+  }
+  std::vector<bool> is_visited(verticies_.size(), false);
+  Heap priority_queue;
+  priority_queue.reset(verticies_.size());
+  // set starting vertex distance to 0 (other verticies are added to the queue when they are reached)
+  (*distances)[starting_vertex->index_] = 0;
+  priority_queue.push(starting_vertex->index_, 0);
+
+  while (priority_queue.empty() == false) {
+    VertexData* current_vertex = verticies_[priority_queue.pop()];
+    if (settled_order != nullptr) {
+      settled_order->push_back(current_vertex->index_);
+    }
+    double current_distance = (*distances)[current_vertex->index_];
+    for (Edge* edge : current_vertex->adjacent_edges_) {
+      uint32_t other_index = edge->getOtherVertex(current_vertex)->index_;
+      if (is_visited[other_index]) {
+        continue;
+      }
+      // update vertex if this distance is smaller (but not if it is equal)
+      double edge_weight = weight(edge);
+      if (edge_weight + current_distance < (*distances)[other_index]) {
+        (*distances)[other_index] = edge_weight + current_distance;
+        if (previous_verticies != nullptr) {
+          (*previous_verticies)[other_index] = current_vertex;
+        }
+        priority_queue.push(other_index, (*distances)[other_index]);
+      }
+    }
+    is_visited[current_vertex->index_] = true;
+  }
+}
+
+template <typename WeightFunction, typename Heap>
+double Graph::shortestPath(Graph::VertexData* source, Graph::VertexData* target,
+    std::vector<Graph::VertexData*>* path, WeightFunction weight) const {
+  std::vector<double> distances(verticies_.size(), std::numeric_limits<double>::infinity());
+  std::vector<VertexData*> previous_verticies(verticies_.size(), nullptr);
+  std::vector<bool> is_visited(verticies_.size(), false);
+  Heap priority_queue;
+  priority_queue.reset(verticies_.size());
+  distances[source->index_] = 0;
+  priority_queue.push(source->index_, 0);
+
+  while (priority_queue.empty() == false) {
+    VertexData* current_vertex = verticies_[priority_queue.pop()];
+    // the target's distance can't get any smaller once it is popped
+    if (current_vertex == target) {
+      break;
+    }
+    double current_distance = distances[current_vertex->index_];
+    for (Edge* edge : current_vertex->adjacent_edges_) {
+      uint32_t other_index = edge->getOtherVertex(current_vertex)->index_;
+      if (is_visited[other_index]) {
+        continue;
+      }
+      // update vertex if this distance is smaller (but not if it is equal)
+      double edge_weight = weight(edge);
+      if (edge_weight + current_distance < distances[other_index]) {
+        distances[other_index] = edge_weight + current_distance;
+        previous_verticies[other_index] = current_vertex;
+        priority_queue.push(other_index, distances[other_index]);
+      }
+    }
+    is_visited[current_vertex->index_] = true;
+  }
+
+  path->clear();
+  double cost = distances[target->index_];
+  if (cost != std::numeric_limits<double>::infinity()) {
+    buildPath(source, target, previous_verticies, path);
+  }
+  return cost;
+}
+
+template <typename WeightFunction, typename Heap>
+double Graph::bidirectionalShortestPath(Graph::VertexData* source, Graph::VertexData* target,
+    std::vector<Graph::VertexData*>* path, WeightFunction weight) const {
+  // index 0 is the search forward from the source, index 1 is the search backward from the target
+  std::vector<double> distances[2];
+  // edge each vertex was reached along (kept instead of the previous vertex, so the cost is added
+  // up from the same edges as the distances even if there are duplicate edges)
+  std::vector<Edge*> previous_edges[2];
+  std::vector<bool> is_visited[2];
+  Heap priority_queues[2];
+  VertexData* starts[2] = {source, target};
+  for (int side = 0; side < 2; ++side) {
+    distances[side].assign(verticies_.size(), std::numeric_limits<double>::infinity());
+    previous_edges[side].assign(verticies_.size(), nullptr);
+    is_visited[side].assign(verticies_.size(), false);
+    priority_queues[side].reset(verticies_.size());
+    distances[side][starts[side]->index_] = 0;
+    priority_queues[side].push(starts[side]->index_, 0);
+  }
+
+  // shortest path found so far between the searches, and the vertex where they meet on it
+  double best_cost = (source == target) ? 0 : std::numeric_limits<double>::infinity();
+  VertexData* meeting_vertex = (source == target) ? source : nullptr;
+
+  while (!priority_queues[0].empty() && !priority_queues[1].empty()) {
+    // any path not found yet is at least as long as the closest unsettled verticies of both searches
+    double forward_key = priority_queues[0].minKey();
+    double backward_key = priority_queues[1].minKey();
+    if (forward_key + backward_key >= best_cost) {
+      break;
+    }
+    int side = (forward_key <= backward_key) ? 0 : 1;
+    std::vector<double>& side_distances = distances[side];
+    const std::vector<double>& other_distances = distances[1 - side];
+
+    VertexData* current_vertex = verticies_[priority_queues[side].pop()];
+    double current_distance = side_distances[current_vertex->index_];
+    for (Edge* edge : current_vertex->adjacent_edges_) {
+      VertexData* other_vertex = edge->getOtherVertex(current_vertex);
+      uint32_t other_index = other_vertex->index_;
+      if (is_visited[side][other_index]) {
+        continue;
+      }
+      // update vertex if this distance is smaller (but not if it is equal)
+      double edge_weight = weight(edge);
+      if (edge_weight + current_distance < side_distances[other_index]) {
+        side_distances[other_index] = edge_weight + current_distance;
+        previous_edges[side][other_index] = edge;
+        priority_queues[side].push(other_index, side_distances[other_index]);
+      }
+      // the edge may join the two searches
+      if (side_distances[other_index] + other_distances[other_index] < best_cost) {
+        best_cost = side_distances[other_index] + other_distances[other_index];
+        meeting_vertex = other_vertex;
+      }
+    }
+    is_visited[side][current_vertex->index_] = true;
+  }
+
+  path->clear();
+  if (meeting_vertex == nullptr) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // count the verticies on each side of the meeting vertex
+  size_t forward_length = 1;
+  for (VertexData* vertex = meeting_vertex; vertex != source;
+      vertex = previous_edges[0][vertex->index_]->getOtherVertex(vertex)) {
+    forward_length += 1;
+  }
+  size_t backward_length = 0;
+  for (VertexData* vertex = meeting_vertex; vertex != target;
+      vertex = previous_edges[1][vertex->index_]->getOtherVertex(vertex)) {
+    backward_length += 1;
+  }
+  path->resize(forward_length + backward_length);
+  VertexData* vertex = meeting_vertex;
+  for (size_t i = forward_length; i > 0; --i) {
+    (*path)[i - 1] = vertex;
+    if (i > 1) {
+      vertex = previous_edges[0][vertex->index_]->getOtherVertex(vertex);
+    }
+  }
+  vertex = meeting_vertex;
+  for (size_t i = forward_length; i < path->size(); ++i) {
+    vertex = previous_edges[1][vertex->index_]->getOtherVertex(vertex);
+    (*path)[i] = vertex;
+  }
+
+  // add up the weights of the relaxed edges from the source (in the same order as a search from
+  // the source would)
+  double cost = 0;
+  for (size_t i = 1; i < forward_length; ++i) {
+    cost += weight(previous_edges[0][(*path)[i]->index_]);
+  }
+  for (size_t i = forward_length; i < path->size(); ++i) {
+    cost += weight(previous_edges[1][(*path)[i - 1]->index_]);
+  }
+  return cost;
+}
+
+template <typename Heuristic, typename WeightFunction, typename Heap>
+double Graph::AStar(Graph::VertexData* source, Graph::VertexData* target, std::vector<Graph::VertexData*>* path,
+    size_t* num_settled, Heuristic heuristic, WeightFunction weight) const {
+  std::vector<double> distances(verticies_.size(), std::numeric_limits<double>::infinity());
+  std::vector<VertexData*> previous_verticies(verticies_.size(), nullptr);
+  std::vector<bool> is_visited(verticies_.size(), false);
+  Heap priority_queue;
+  priority_queue.reset(verticies_.size());
+  distances[source->index_] = 0;
+  // verticies are keyed by their distance from the source plus their bound on the distance left
+  priority_queue.push(source->index_, heuristic(source, target));
+  size_t settled = 0;
+
+  while (priority_queue.empty() == false) {
+    VertexData* current_vertex = verticies_[priority_queue.pop()];
+    settled += 1;
+    if (current_vertex == target) {
+      break;
+    }
+    double current_distance = distances[current_vertex->index_];
+    for (Edge* edge : current_vertex->adjacent_edges_) {
+      VertexData* other_vertex = edge->getOtherVertex(current_vertex);
+      uint32_t other_index = other_vertex->index_;
+      if (is_visited[other_index]) {
+        continue;
+      }
+      // update vertex if this distance is smaller (but not if it is equal)
+      double edge_weight = weight(edge);
+      if (edge_weight + current_distance < distances[other_index]) {
+        distances[other_index] = edge_weight + current_distance;
+        previous_verticies[other_index] = current_vertex;
+        priority_queue.push(other_index, distances[other_index] + heuristic(other_vertex, target));
+      }
+    }
+    is_visited[current_vertex->index_] = true;
+  }
+
+  if (num_settled != nullptr) {
+    *num_settled = settled;
+  }
+  path->clear();
+  double cost = distances[target->index_];
+  if (cost != std::numeric_limits<double>::infinity()) {
+    buildPath(source, target, previous_verticies, path);
+  }
+  return cost;
+}
+
+template <typename WeightFunction, typename Heap>
+std::vector<double> Graph::distanceMatrix(const std::vector<Graph::VertexData*>& sources,
+    const std::vector<Graph::VertexData*>& targets, size_t num_threads, WeightFunction weight) const {
+  std::vector<double> matrix(sources.size() * targets.size(), std::numeric_limits<double>::infinity());
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_threads = std::min(num_threads, std::max<size_t>(1, sources.size()));
+
+  // mark the targets, so a search can stop once it has settled all of them
+  std::vector<bool> is_target(verticies_.size(), false);
+  size_t num_distinct_targets = 0;
+  for (VertexData* target : targets) {
+    if (!is_target[target->index_]) {
+      is_target[target->index_] = true;
+      num_distinct_targets += 1;
+    }
+  }
+
+  // each thread takes the next source that hasn't been searched from
+  std::atomic<size_t> next_source(0);
+  auto searchSources = [&]() {
+    std::vector<double> distances;
+    std::vector<bool> is_visited;
+    Heap priority_queue;
+    for (size_t row = next_source++; row < sources.size(); row = next_source++) {
+      distances.assign(verticies_.size(), std::numeric_limits<double>::infinity());
+      is_visited.assign(verticies_.size(), false);
+      priority_queue.reset(verticies_.size());
+      distances[sources[row]->index_] = 0;
+      priority_queue.push(sources[row]->index_, 0);
+
+      size_t num_settled_targets = 0;
+      while (priority_queue.empty() == false && num_settled_targets < num_distinct_targets) {
+        VertexData* current_vertex = verticies_[priority_queue.pop()];
+        if (is_target[current_vertex->index_]) {
+          num_settled_targets += 1;
+        }
+        double current_distance = distances[current_vertex->index_];
+        for (Edge* edge : current_vertex->adjacent_edges_) {
+          uint32_t other_index = edge->getOtherVertex(current_vertex)->index_;
+          if (is_visited[other_index]) {
+            continue;
+          }
+          double edge_weight = weight(edge);
+          if (edge_weight + current_distance < distances[other_index]) {
+            distances[other_index] = edge_weight + current_distance;
+            priority_queue.push(other_index, distances[other_index]);
+          }
+        }
+        is_visited[current_vertex->index_] = true;
+      }
+
+      // every thread writes its own rows
+      double* matrix_row = matrix.data() + row * targets.size();
+      for (size_t column = 0; column < targets.size(); ++column) {
+        matrix_row[column] = distances[targets[column]->index_];
+      }
+    }
+  };
+
+  if (num_threads == 1) {
+    searchSources();
+    return matrix;
+  }
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers.emplace_back(searchSources);
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  return matrix;
+}
+
+template <typename WeightFunction>
+double Graph::getLargestHamiltonianCycleHeldKarp(std::vector<Graph::VertexData*>* cycle, size_t num_threads,
+    WeightFunction weight) const {
+  const double kNoPath = -std::numeric_limits<double>::infinity();
+  cycle->clear();
+  size_t num_verticies = verticies_.size();
+  if (num_verticies < 2 || num_verticies > kMaxHeldKarpVerticies) {
+    return kNoPath;
+  }
+
+  // the start (the station with the smallest id) is at position 0, the other verticies follow in
+  // index order, and the weight between positions is kept in a flat matrix
+  std::vector<VertexData*> positions;
+  positions.reserve(num_verticies);
+  VertexData* start = verticies_[0];
+  for (VertexData* vertex : verticies_) {
+    if (vertex->station_.id_ < start->station_.id_) {
+      start = vertex;
+    }
+  }
+  positions.push_back(start);
+  std::vector<uint32_t> vertex_positions(num_verticies, 0);
+  for (VertexData* vertex : verticies_) {
+    if (vertex != start) {
+      vertex_positions[vertex->index_] = static_cast<uint32_t>(positions.size());
+      positions.push_back(vertex);
+    }
+  }
+  std::vector<double> weights(num_verticies * num_verticies, kNoPath);
+  for (Edge* edge : edges_) {
+    double edge_weight = weight(edge);
+    if (edge_weight == std::numeric_limits<double>::infinity()) {
+      continue;
+    }
+    // keep the heaviest of repeated edges
+    uint32_t one = vertex_positions[edge->start_vertex_->index_];
+    uint32_t two = vertex_positions[edge->end_vertex_->index_];
+    weights[one * num_verticies + two] = std::max(weights[one * num_verticies + two], edge_weight);
+    weights[two * num_verticies + one] = weights[one * num_verticies + two];
+  }
+
+  // bit i of a set is the vertex at position i + 1; the entry for (S, v) is stored at
+  // v * half + (S without v, with the bits above v shifted down), so no entry is wasted
+  size_t num_others = num_verticies - 1;
+  uint32_t half = 1u << (num_others - 1);
+  auto entry = [half](uint32_t set_without_end, uint32_t end) {
+    uint32_t below = set_without_end & ((1u << end) - 1);
+    uint32_t above = (set_without_end >> (end + 1)) << end;
+    return static_cast<size_t>(end) * half + (below | above);
+  };
+  std::vector<double> largest(num_others * half, kNoPath);
+
+  // binomials[c][i] is the number of sets of i verticies out of c
+  uint32_t binomials[kMaxHeldKarpVerticies][kMaxHeldKarpVerticies] = {};
+  for (size_t c = 0; c <= num_others; ++c) {
+    binomials[c][0] = 1;
+    for (size_t i = 1; i <= c; ++i) {
+      binomials[c][i] = binomials[c - 1][i - 1] + (i < c ? binomials[c - 1][i] : 0);
+    }
+  }
+  // the sets of one size in increasing order, by rank: the set at a rank is found from the
+  // binomials, and the next set from Gosper's hack (move the lowest block of bits up by one)
+  auto getSet = [&binomials, num_others](uint32_t rank, size_t set_size) {
+    uint32_t set = 0;
+    for (size_t i = set_size; i > 0; --i) {
+      size_t c = i - 1;
+      while (c + 1 < num_others && binomials[c + 1][i] <= rank) {
+        c += 1;
+      }
+      set |= 1u << c;
+      rank -= binomials[c][i];
+    }
+    return set;
+  };
+  auto getNextSet = [](uint32_t set) {
+    uint32_t lowest_bit = set & (~set + 1);
+    uint32_t moved = set + lowest_bit;
+    return (((moved ^ set) >> 2) / lowest_bit) | moved;
+  };
+
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const uint32_t kSetsPerTask = 4096;
+  uint32_t most_sets = binomials[num_others][num_others / 2];
+  num_threads = std::min<size_t>(num_threads, (most_sets + kSetsPerTask - 1) / kSetsPerTask);
+  // rank of the next block of sets of each size for a thread to take
+  std::atomic<uint32_t> next_ranks[kMaxHeldKarpVerticies];
+  for (std::atomic<uint32_t>& next_rank : next_ranks) {
+    next_rank = 0;
+  }
+  // the threads wait for each other after each size, since the sets of a size only read the
+  // sets one smaller
+  std::mutex mutex;
+  std::condition_variable size_filled;
+  size_t num_waiting = 0;
+  size_t num_sizes_filled = 0;
+  auto fillSets = [&]() {
+    for (size_t set_size = 1; set_size <= num_others; ++set_size) {
+      uint32_t num_sets_of_size = binomials[num_others][set_size];
+      for (uint32_t begin = next_ranks[set_size].fetch_add(kSetsPerTask); begin < num_sets_of_size;
+          begin = next_ranks[set_size].fetch_add(kSetsPerTask)) {
+        uint32_t end = std::min(num_sets_of_size, begin + kSetsPerTask);
+        uint32_t set = getSet(begin, set_size);
+        for (uint32_t rank = begin; rank < end; ++rank, set = getNextSet(set)) {
+          for (uint32_t last = 0; last < num_others; ++last) {
+            uint32_t last_bit = 1u << last;
+            if ((set & last_bit) == 0) {
+              continue;
+            }
+            uint32_t previous_set = set ^ last_bit;
+            const double* last_weights = weights.data() + (last + 1) * num_verticies;
+            double best = kNoPath;
+            if (previous_set == 0) {
+              best = last_weights[0];
+            }
+            for (uint32_t previous = 0; previous < num_others; ++previous) {
+              uint32_t previous_bit = 1u << previous;
+              if ((previous_set & previous_bit) == 0 || last_weights[previous + 1] == kNoPath) {
+                continue;
+              }
+              best = std::max(best, largest[entry(previous_set ^ previous_bit, previous)] + last_weights[previous + 1]);
+            }
+            largest[entry(previous_set, last)] = best;
+          }
+        }
+      }
+      if (num_threads <= 1) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      size_t sizes_filled = num_sizes_filled;
+      num_waiting += 1;
+      if (num_waiting == num_threads) {
+        num_waiting = 0;
+        num_sizes_filled += 1;
+        size_filled.notify_all();
+      } else {
+        size_filled.wait(lock, [&]() { return num_sizes_filled != sizes_filled; });
+      }
+    }
+  };
+  // the calling thread fills sets along with the other threads
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < num_threads; ++i) {
+    workers.emplace_back(fillSets);
+  }
+  fillSets();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // close the cycle from the best last vertex back to the start
+  uint32_t all_others = (1u << num_others) - 1;
+  double best_cycle = kNoPath;
+  uint32_t last = 0;
+  for (uint32_t end = 0; end < num_others; ++end) {
+    double closing_weight = weights[(end + 1) * num_verticies];
+    if (closing_weight == kNoPath) {
+      continue;
+    }
+    double cycle_weight = largest[entry(all_others ^ (1u << end), end)] + closing_weight;
+    if (cycle_weight > best_cycle) {
+      best_cycle = cycle_weight;
+      last = end;
+    }
+  }
+  if (best_cycle == kNoPath) {
+    return kNoPath;
+  }
+
+  // trace the path back: the previous vertex is one whose entry plus its edge gives this entry
+  cycle->resize(num_verticies);
+  (*cycle)[0] = start;
+  uint32_t set = all_others;
+  for (size_t position = num_others; position > 0; --position) {
+    (*cycle)[position] = positions[last + 1];
+    uint32_t previous_set = set ^ (1u << last);
+    double path_weight = largest[entry(previous_set, last)];
+    const double* last_weights = weights.data() + (last + 1) * num_verticies;
+    for (uint32_t previous = 0; previous < num_others; ++previous) {
+      uint32_t previous_bit = 1u << previous;
+      if ((previous_set & previous_bit) != 0 && last_weights[previous + 1] != kNoPath
+          && largest[entry(previous_set ^ previous_bit, previous)] + last_weights[previous + 1] == path_weight) {
+        last = previous;
+        break;
+      }
+    }
+    set = previous_set;
+  }
+  return best_cycle;
+}
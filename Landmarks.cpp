@@ -0,0 +1,154 @@
+#include "Landmarks.h"
+#include "MappedFile.h"
+#include "Snapshot.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+static_assert(sizeof(Landmarks::Header) % 8 == 0, "Header must keep the tables 8 byte aligned");
+
+namespace {
+  const char kLandmarksMagic[8] = {'C', 'B', 'L', 'N', 'D', 'M', 'K', '\0'};
+
+  // largest relative error of rounding a distance to a float (2^-24), with some room to spare
+  const double kRoundingSlack = 1e-7;
+
+  /**
+   * Finds the size of a landmarks file with the given counts
+   */
+  size_t getLandmarksFileSize(uint64_t num_verticies, uint64_t num_landmarks) {
+    return sizeof(Landmarks::Header) + num_verticies * sizeof(int32_t) + num_landmarks * sizeof(uint32_t)
+        + num_verticies * num_landmarks * sizeof(float);
+  }
+}
+
+const uint32_t Landmarks::kVersion;
+const size_t Landmarks::kDefaultNumLandmarks;
+
+bool Landmarks::save(const std::string& file_path, uint64_t graph_checksum) const {
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic_, kLandmarksMagic, sizeof(kLandmarksMagic));
+  header.version_ = kVersion;
+  header.header_size_ = sizeof(Header);
+  header.num_verticies_ = num_verticies_;
+  header.num_landmarks_ = landmarks_.size();
+  header.graph_checksum_ = graph_checksum;
+
+  std::vector<char> buffer(getLandmarksFileSize(header.num_verticies_, header.num_landmarks_), 0);
+  char* data = buffer.data() + sizeof(Header);
+  std::memcpy(data, station_ids_.data(), station_ids_.size() * sizeof(int32_t));
+  data += station_ids_.size() * sizeof(int32_t);
+  std::memcpy(data, landmarks_.data(), landmarks_.size() * sizeof(uint32_t));
+  data += landmarks_.size() * sizeof(uint32_t);
+  std::memcpy(data, distances_.data(), distances_.size() * sizeof(float));
+  header.checksum_ = Snapshot::computeChecksum(buffer.data() + sizeof(Header), buffer.data() + buffer.size());
+  std::memcpy(buffer.data(), &header, sizeof(Header));
+
+  // write to a temporary file and rename it over the tables
+  std::string temporary_path = file_path + ".tmp";
+  {
+    std::ofstream landmarks_file(temporary_path, std::ios::binary | std::ios::trunc);
+    if (!landmarks_file.is_open()) {
+      return false;
+    }
+    landmarks_file.write(buffer.data(), buffer.size());
+    if (!landmarks_file.good()) {
+      std::remove(temporary_path.c_str());
+      return false;
+    }
+  }
+  return std::rename(temporary_path.c_str(), file_path.c_str()) == 0;
+}
+
+bool Landmarks::load(const std::string& file_path, const Graph& graph, uint64_t graph_checksum) {
+  MappedFile file(file_path, false);
+  if (!file.isMapped() || file.size() < sizeof(Header)) {
+    return false;
+  }
+  Header header;
+  std::memcpy(&header, file.data(), sizeof(Header));
+  if (std::memcmp(header.magic_, kLandmarksMagic, sizeof(kLandmarksMagic)) != 0 || header.version_ != kVersion
+      || header.header_size_ != sizeof(Header)) {
+    return false;
+  }
+  // counts that don't fit in the file would overflow the size
+  if (header.num_verticies_ >= file.size() || header.num_landmarks_ >= file.size()
+      || header.num_landmarks_ > header.num_verticies_
+      || getLandmarksFileSize(header.num_verticies_, header.num_landmarks_) != file.size()
+      || Snapshot::computeChecksum(file.data() + sizeof(Header), file.data() + file.size()) != header.checksum_) {
+    return false;
+  }
+
+  // the tables must have been built from the same edges and stations, in the same order
+  const char* data = file.data() + sizeof(Header);
+  if (header.graph_checksum_ != graph_checksum || header.num_verticies_ != graph.size()) {
+    return false;
+  }
+  std::vector<int32_t> station_ids(header.num_verticies_);
+  std::memcpy(station_ids.data(), data, station_ids.size() * sizeof(int32_t));
+  data += station_ids.size() * sizeof(int32_t);
+  for (uint32_t vertex = 0; vertex < station_ids.size(); ++vertex) {
+    if (graph.getVertexByIndex(vertex)->station_.id_ != station_ids[vertex]) {
+      return false;
+    }
+  }
+  std::vector<uint32_t> landmarks(header.num_landmarks_);
+  std::memcpy(landmarks.data(), data, landmarks.size() * sizeof(uint32_t));
+  data += landmarks.size() * sizeof(uint32_t);
+  for (uint32_t landmark : landmarks) {
+    if (landmark >= header.num_verticies_) {
+      return false;
+    }
+  }
+
+  num_verticies_ = header.num_verticies_;
+  station_ids_.swap(station_ids);
+  landmarks_.swap(landmarks);
+  distances_.resize(num_verticies_ * landmarks_.size());
+  std::memcpy(distances_.data(), data, distances_.size() * sizeof(float));
+  return true;
+}
+
+size_t Landmarks::getNumLandmarks() const {
+  return landmarks_.size();
+}
+
+const std::vector<uint32_t>& Landmarks::getLandmarks() const {
+  return landmarks_;
+}
+
+double Landmarks::getDistance(size_t landmark, uint32_t vertex) const {
+  return distances_[vertex * landmarks_.size() + landmark];
+}
+
+double Landmarks::getLowerBound(const Graph::VertexData* vertex, const Graph::VertexData* target) const {
+  size_t num_landmarks = landmarks_.size();
+  const float* vertex_distances = distances_.data() + vertex->index_ * num_landmarks;
+  const float* target_distances = distances_.data() + target->index_ * num_landmarks;
+  double bound = 0;
+  for (size_t landmark = 0; landmark < num_landmarks; ++landmark) {
+    double vertex_distance = vertex_distances[landmark];
+    double target_distance = target_distances[landmark];
+    if (std::isinf(vertex_distance) || std::isinf(target_distance)) {
+      // a landmark can reach only one of the verticies if they are in different components
+      if (vertex_distance != target_distance) {
+        return std::numeric_limits<double>::infinity();
+      }
+      continue;
+    }
+    // both distances were rounded to floats, so take off the most the rounding could have added
+    double landmark_bound = std::fabs(target_distance - vertex_distance)
+        - kRoundingSlack * (target_distance + vertex_distance);
+    bound = std::max(bound, landmark_bound);
+  }
+  return bound;
+}
+
+Landmarks::Heuristic Landmarks::getHeuristic() const {
+  Heuristic heuristic;
+  heuristic.landmarks_ = this;
+  return heuristic;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Class storing the distances from a few landmark verticies to every vertex of a Graph, used as
+ * an A* heuristic (the ALT algorithm: A*, landmarks and the triangle inequality)
+ * For any landmark L, the distance from a vertex to the target is at least
+ * |distance(L, target) - distance(L, vertex)|, and the largest of these bounds is often close
+ * to the real distance, so A* settles few verticies
+ * Landmarks are picked far apart (each is the vertex farthest from the ones picked before it),
+ * so every vertex has a landmark "behind" it
+ * The tables are tied to the Graph they were built from (its dense vertex indices and weights),
+ * and are built again when the graph changes
+ *
+ * File layout (numbers are in the host's byte order):
+ *    Header
+ *    int32_t[num_verticies_]                    station id of each vertex, by dense index
+ *    uint32_t[num_landmarks_]                   dense index of each landmark
+ *    float[num_verticies_ * num_landmarks_]     distance tables (see distances_)
+ */
+class Landmarks {
+  public:
+    // version of the file layout (files with any other version are not loaded)
+    static const uint32_t kVersion = 2;
+
+    // number of landmarks used if none is given
+    static const size_t kDefaultNumLandmarks = 16;
+
+    /**
+     * Struct storing the first bytes of a landmarks file
+     */
+    struct Header {
+      // identifies the file as landmark tables ("CBLNDMK" followed by a null character)
+      char magic_[8];
+      // version of the layout the file was written with
+      uint32_t version_;
+      // size of the header in bytes
+      uint32_t header_size_;
+      // number of verticies of the graph the tables were built from
+      uint64_t num_verticies_;
+      // number of landmarks
+      uint64_t num_landmarks_;
+      // checksum of the snapshot of the graph the tables were built from (ties the tables to its edges)
+      uint64_t graph_checksum_;
+      // checksum of every byte after the header (see Snapshot::computeChecksum)
+      uint64_t checksum_;
+    };
+
+    /**
+     * Heuristic for Graph::AStar that uses the landmark tables
+     * Only a lower bound for the weight function the tables were built with
+     */
+    struct Heuristic {
+      const Landmarks* landmarks_;
+
+      double operator()(const Graph::VertexData* vertex, const Graph::VertexData* target) const {
+        return landmarks_->getLowerBound(vertex, target);
+      }
+    };
+
+    /**
+     * Default Constructor (no landmarks, every lower bound is 0)
+     */
+    Landmarks() {}
+
+    /**
+     * Picks landmarks in a graph and finds the distance from each landmark to every vertex
+     * The first landmark is the vertex farthest from the first vertex, and each next landmark is the
+     * vertex farthest from all of the landmarks before it (verticies that can't be reached count as
+     * farthest, so every connected component gets a landmark), using one Dijkstras per landmark
+     *
+     * @tparam WeightFunction the weight function used for edges (see Graph::Dijkstras)
+     * @param graph the Graph to pick landmarks in
+     * @param num_landmarks the number of landmarks to pick (at most the number of verticies)
+     * @param weight the weight function to use for edges
+     */
+    template <typename WeightFunction = Graph::GeometricDistance>
+    Landmarks(const Graph& graph, size_t num_landmarks, WeightFunction weight = WeightFunction());
+
+    /**
+     * Writes the tables to a file (written next to the given path and then renamed, like a snapshot)
+     *
+     * @param file_path a string representing the path to write the tables to
+     * @param graph_checksum the checksum of the snapshot of the graph the tables were built from
+     *    (Snapshot::Header::checksum_)
+     * @return true if the file was written
+     */
+    bool save(const std::string& file_path, uint64_t graph_checksum) const;
+
+    /**
+     * Replaces the tables with the tables in a file
+     * The file is only used if it is complete, its checksum matches, and it was built from a graph
+     * with the same snapshot checksum (the same edges) and the same stations at the same dense
+     * indices as the given graph, since tables of other edges could overestimate distances
+     *
+     * @param file_path a string representing the path to the tables
+     * @param graph the Graph the tables will be used with
+     * @param graph_checksum the checksum of the snapshot the graph was loaded from or saved to
+     *    (Snapshot::Header::checksum_)
+     * @return true if the tables were loaded (if false, the tables are unchanged)
+     */
+    bool load(const std::string& file_path, const Graph& graph, uint64_t graph_checksum);
+
+    /**
+     * Retrieves the number of landmarks
+     *
+     * @return the number of landmarks
+     */
+    size_t getNumLandmarks() const;
+
+    /**
+     * Retrieves the landmarks
+     *
+     * @return the dense vertex index of each landmark, in the order they were picked
+     */
+    const std::vector<uint32_t>& getLandmarks() const;
+
+    /**
+     * Retrieves the distance from a landmark to a vertex
+     *
+     * @param landmark the position of the landmark in getLandmarks()
+     * @param vertex the dense index of the vertex
+     * @return the distance (rounded to a float, infinity if the vertex can't be reached)
+     */
+    double getDistance(size_t landmark, uint32_t vertex) const;
+
+    /**
+     * Finds a lower bound on the distance between two verticies using the triangle inequality
+     *
+     * @param vertex a pointer to the vertex to bound the distance from
+     * @param target a pointer to the vertex to bound the distance to
+     * @return the largest bound of any landmark (infinity if the verticies are not connected)
+     */
+    double getLowerBound(const Graph::VertexData* vertex, const Graph::VertexData* target) const;
+
+    /**
+     * Retrieves a heuristic for Graph::AStar that uses these tables
+     *
+     * @return a Heuristic pointing at these tables (it must not outlive them)
+     */
+    Heuristic getHeuristic() const;
+
+  private:
+    // number of verticies of the graph the tables were built from
+    size_t num_verticies_ = 0;
+
+    // station id of each vertex by dense index (so a file can be checked against a graph)
+    std::vector<int32_t> station_ids_;
+
+    // dense index of each landmark
+    std::vector<uint32_t> landmarks_;
+
+    // distance from each landmark to each vertex, stored by vertex so the distances a bound
+    // needs are next to each other: the distance from landmark l to vertex v is at
+    // distances_[v * getNumLandmarks() + l]
+    // floats halve the size of the tables, and the bounds allow for their rounding
+    std::vector<float> distances_;
+};
+
+#include "Landmarks.hpp"
@@ -0,0 +1,41 @@
+/**
+ * Definitions of the Landmarks' template member functions
+ * (included at the bottom of Landmarks.h)
+ */
+
+template <typename WeightFunction>
+Landmarks::Landmarks(const Graph& graph, size_t num_landmarks, WeightFunction weight) {
+  const std::vector<Graph::VertexData*>& verticies = graph.getVertexList();
+  num_verticies_ = verticies.size();
+  station_ids_.reserve(num_verticies_);
+  for (Graph::VertexData* vertex : verticies) {
+    station_ids_.push_back(vertex->station_.id_);
+  }
+  if (num_verticies_ == 0) {
+    return;
+  }
+  num_landmarks = std::min(num_landmarks, num_verticies_);
+
+  // distance from each vertex to the closest landmark picked so far
+  std::vector<double> closest_distances(num_verticies_, std::numeric_limits<double>::infinity());
+  distances_.resize(num_verticies_ * num_landmarks);
+  std::vector<double> distances;
+  graph.Dijkstras(verticies[0], &distances, nullptr, weight);
+  while (landmarks_.size() < num_landmarks) {
+    // pick the vertex farthest from the first vertex (for the first landmark) or from every landmark
+    const std::vector<double>& farthest_from = landmarks_.empty() ? distances : closest_distances;
+    uint32_t landmark = 0;
+    for (uint32_t vertex = 1; vertex < num_verticies_; ++vertex) {
+      if (farthest_from[vertex] > farthest_from[landmark]) {
+        landmark = vertex;
+      }
+    }
+    landmarks_.push_back(landmark);
+
+    graph.Dijkstras(verticies[landmark], &distances, nullptr, weight);
+    for (uint32_t vertex = 0; vertex < num_verticies_; ++vertex) {
+      closest_distances[vertex] = std::min(closest_distances[vertex], distances[vertex]);
+      distances_[vertex * num_landmarks + landmarks_.size() - 1] = static_cast<float>(distances[vertex]);
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& file_path, bool sequential) {
+  file_descriptor_ = open(file_path.c_str(), O_RDONLY);
+  if (file_descriptor_ < 0) {
+    return;
+  }
+
+  // only regular files can be mapped (pipes are read through the file descriptor)
+  struct stat file_status;
+  if (fstat(file_descriptor_, &file_status) != 0 || !S_ISREG(file_status.st_mode)
+      || file_status.st_size == 0) {
+    return;
+  }
+
+  size_t size = static_cast<size_t>(file_status.st_size);
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+  if (mapping == MAP_FAILED) {
+    return;
+  }
+  if (sequential) {
+    madvise(mapping, size, MADV_SEQUENTIAL);
+  }
+  data_ = static_cast<const char*>(mapping);
+  size_ = size;
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  if (file_descriptor_ >= 0) {
+    close(file_descriptor_);
+  }
+}
+
+bool MappedFile::isOpen() const {
+  return file_descriptor_ >= 0;
+}
+
+bool MappedFile::isMapped() const {
+  return data_ != nullptr;
+}
+
+const char* MappedFile::data() const {
+  return data_;
+}
+
+size_t MappedFile::size() const {
+  return size_;
+}
+
+int MappedFile::getFileDescriptor() const {
+  return file_descriptor_;
+}
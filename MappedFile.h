@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Class representing a read-only memory mapping of a file
+ * If the file can't be mapped (pipes, empty files), the file is left open so it
+ * can be read from through getFileDescriptor() instead
+ */
+class MappedFile {
+  public:
+    /**
+     * Opens and maps the file at the given path
+     *
+     * @param file_path a string representing the path to the file
+     * @param sequential a bool that is true if the mapping will be read from front to back
+     *    (the kernel is told to read ahead and drop pages behind the reader)
+     */
+    MappedFile(const std::string& file_path, bool sequential);
+
+    /**
+     * Destructor
+     * Unmaps and closes the file
+     */
+    ~MappedFile();
+
+    // the mapping can't be shared between objects
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& rhs) = delete;
+
+    /**
+     * Checks if the file was opened
+     *
+     * @return true if the file exists and could be opened
+     */
+    bool isOpen() const;
+
+    /**
+     * Checks if the file was mapped into memory
+     *
+     * @return true if data() can be read from, false if the file has to be read through
+     *    getFileDescriptor()
+     */
+    bool isMapped() const;
+
+    /**
+     * Retrieves the mapped contents of the file
+     *
+     * @return a pointer to the first byte of the file (nullptr if not mapped)
+     */
+    const char* data() const;
+
+    /**
+     * Retrieves the size of the mapped file
+     *
+     * @return the number of bytes in the mapping (0 if not mapped)
+     */
+    size_t size() const;
+
+    /**
+     * Retrieves the file descriptor of the opened file
+     *
+     * @return the file descriptor of the file (-1 if the file couldn't be opened)
+     */
+    int getFileDescriptor() const;
+
+  private:
+    // file descriptor of the opened file
+    int file_descriptor_ = -1;
+    // pointer to the start of the mapping
+    const char* data_ = nullptr;
+    // number of bytes in the mapping
+    size_t size_ = 0;
+};
@@ -0,0 +1,230 @@
+#include "Snapshot.h"
+#include "StaticGraph.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#include <type_traits>
+
+// stations and edge records are written and mapped as raw bytes
+static_assert(sizeof(Graph::Station) == 24 && offsetof(Graph::Station, id_) == 0
+    && offsetof(Graph::Station, latitude_) == 8 && offsetof(Graph::Station, longitude_) == 16,
+    "snapshots expect a 24 byte Graph::Station");
+static_assert(std::is_trivially_copyable<Snapshot::EdgeRecord>::value, "EdgeRecord must be trivially copyable");
+static_assert(std::is_trivially_copyable<Snapshot::SourceFile>::value, "SourceFile must be trivially copyable");
+static_assert(sizeof(Snapshot::Header) % 8 == 0, "Header must keep the sections 8 byte aligned");
+
+namespace {
+  const char kMagic[8] = {'C', 'B', 'G', 'R', 'A', 'P', 'H', '\0'};
+
+  // rounds a size up to a multiple of 8 bytes
+  size_t alignSection(size_t size) {
+    return (size + 7) & ~static_cast<size_t>(7);
+  }
+}
+
+const uint32_t Snapshot::kVersion;
+const size_t Snapshot::kMaxSourcePathSize;
+
+bool Snapshot::write(const std::string& file_path, const StaticGraph& graph, const std::vector<EdgeRecord>& edges,
+    const std::vector<SourceFile>& source_files) {
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic_, kMagic, sizeof(kMagic));
+  header.version_ = kVersion;
+  header.header_size_ = sizeof(Header);
+  header.num_verticies_ = graph.size();
+  header.num_adjacencies_ = 2 * graph.getNumEdges();
+  header.num_edges_ = edges.size();
+  header.total_weight_ = graph.getTotalWeight();
+  header.num_source_files_ = source_files.size();
+  Layout layout = getLayout(header);
+
+  // build the whole file in memory (zeroed, so padding bytes are deterministic)
+  std::vector<char> buffer(layout.size_, 0);
+  char* data = buffer.data();
+  uint32_t offset = 0;
+  for (uint32_t vertex = 0; vertex < graph.size(); ++vertex) {
+    const Graph::Station& station = graph.getStation(vertex);
+    char* station_data = data + layout.stations_ + vertex * sizeof(Graph::Station);
+    std::memcpy(station_data + offsetof(Graph::Station, id_), &station.id_, sizeof(station.id_));
+    std::memcpy(station_data + offsetof(Graph::Station, latitude_), &station.latitude_, sizeof(station.latitude_));
+    std::memcpy(station_data + offsetof(Graph::Station, longitude_), &station.longitude_, sizeof(station.longitude_));
+
+    uint32_t degree = graph.getDegree(vertex);
+    std::memcpy(data + layout.offsets_ + vertex * sizeof(uint32_t), &offset, sizeof(offset));
+    std::memcpy(data + layout.neighbors_ + offset * sizeof(uint32_t), graph.getNeighbors(vertex),
+        degree * sizeof(uint32_t));
+    std::memcpy(data + layout.weights_ + offset * sizeof(double), graph.getWeights(vertex), degree * sizeof(double));
+    offset += degree;
+  }
+  std::memcpy(data + layout.offsets_ + graph.size() * sizeof(uint32_t), &offset, sizeof(offset));
+  if (!edges.empty()) {
+    std::memcpy(data + layout.edges_, edges.data(), edges.size() * sizeof(EdgeRecord));
+  }
+  if (!source_files.empty()) {
+    std::memcpy(data + layout.source_files_, source_files.data(), source_files.size() * sizeof(SourceFile));
+  }
+  header.checksum_ = computeChecksum(data + sizeof(Header), data + layout.size_);
+  std::memcpy(data, &header, sizeof(Header));
+
+  // write to a temporary file and rename it over the snapshot
+  std::string temporary_path = file_path + ".tmp";
+  {
+    std::ofstream snapshot_file(temporary_path, std::ios::binary | std::ios::trunc);
+    if (!snapshot_file.is_open()) {
+      return false;
+    }
+    snapshot_file.write(data, buffer.size());
+    if (!snapshot_file.good()) {
+      std::remove(temporary_path.c_str());
+      return false;
+    }
+  }
+  return std::rename(temporary_path.c_str(), file_path.c_str()) == 0;
+}
+
+bool Snapshot::findSourceFiles(const std::vector<std::string>& file_paths, std::vector<SourceFile>* source_files) {
+  source_files->clear();
+  for (const std::string& file_path : file_paths) {
+    struct stat file_status;
+    if (stat(file_path.c_str(), &file_status) != 0) {
+      continue;
+    }
+    if (file_path.size() >= kMaxSourcePathSize) {
+      return false;
+    }
+    SourceFile source_file;
+    std::memset(&source_file, 0, sizeof(source_file));
+    std::memcpy(source_file.path_, file_path.data(), file_path.size());
+    source_file.size_ = file_status.st_size;
+    source_file.modified_time_ = file_status.st_mtime;
+    source_files->push_back(source_file);
+  }
+  return true;
+}
+
+Snapshot::Snapshot(const std::string& file_path) : file_(file_path, false) {
+  std::memset(&header_, 0, sizeof(header_));
+  if (!file_.isMapped() || file_.size() < sizeof(Header)) {
+    return;
+  }
+  std::memcpy(&header_, file_.data(), sizeof(Header));
+  if (std::memcmp(header_.magic_, kMagic, sizeof(kMagic)) != 0 || header_.version_ != kVersion
+      || header_.header_size_ != sizeof(Header)) {
+    return;
+  }
+  // counts that don't fit in the file would overflow the layout
+  if (header_.num_verticies_ >= file_.size() || header_.num_adjacencies_ >= file_.size()
+      || header_.num_edges_ >= file_.size() || header_.num_source_files_ >= file_.size()) {
+    return;
+  }
+  layout_ = getLayout(header_);
+  if (layout_.size_ != file_.size()
+      || computeChecksum(file_.data() + sizeof(Header), file_.data() + file_.size()) != header_.checksum_) {
+    return;
+  }
+
+  // make sure every index stays inside the arrays
+  // (StaticGraph reads the offsets and neighbors in place, so a file with a matching checksum still
+  // can't be trusted to have them in range)
+  const uint32_t* offsets = getOffsets();
+  if (offsets[0] != 0 || offsets[header_.num_verticies_] != header_.num_adjacencies_) {
+    return;
+  }
+  for (uint64_t vertex = 0; vertex < header_.num_verticies_; ++vertex) {
+    if (offsets[vertex] > offsets[vertex + 1]) {
+      return;
+    }
+  }
+  const uint32_t* neighbors = getNeighbors();
+  for (uint64_t i = 0; i < header_.num_adjacencies_; ++i) {
+    if (neighbors[i] >= header_.num_verticies_) {
+      return;
+    }
+  }
+  for (uint64_t i = 0; i < header_.num_edges_; ++i) {
+    if (getEdges()[i].start_vertex_ >= header_.num_verticies_ || getEdges()[i].end_vertex_ >= header_.num_verticies_) {
+      return;
+    }
+  }
+  is_valid_ = true;
+}
+
+bool Snapshot::isValid() const {
+  return is_valid_;
+}
+
+const Snapshot::Header& Snapshot::getHeader() const {
+  return header_;
+}
+
+const Graph::Station* Snapshot::getStations() const {
+  return reinterpret_cast<const Graph::Station*>(file_.data() + layout_.stations_);
+}
+
+const uint32_t* Snapshot::getOffsets() const {
+  return reinterpret_cast<const uint32_t*>(file_.data() + layout_.offsets_);
+}
+
+const uint32_t* Snapshot::getNeighbors() const {
+  return reinterpret_cast<const uint32_t*>(file_.data() + layout_.neighbors_);
+}
+
+const double* Snapshot::getWeights() const {
+  return reinterpret_cast<const double*>(file_.data() + layout_.weights_);
+}
+
+const Snapshot::EdgeRecord* Snapshot::getEdges() const {
+  return reinterpret_cast<const EdgeRecord*>(file_.data() + layout_.edges_);
+}
+
+const Snapshot::SourceFile* Snapshot::getSourceFiles() const {
+  return reinterpret_cast<const SourceFile*>(file_.data() + layout_.source_files_);
+}
+
+bool Snapshot::isBuiltFrom(const std::vector<std::string>& file_paths) const {
+  std::vector<SourceFile> source_files;
+  if (!is_valid_ || !findSourceFiles(file_paths, &source_files) || source_files.size() != header_.num_source_files_) {
+    return false;
+  }
+  // a file added, removed or changed since the snapshot was built makes the lists differ
+  for (size_t i = 0; i < source_files.size(); ++i) {
+    const SourceFile& built_from = getSourceFiles()[i];
+    if (std::strncmp(source_files[i].path_, built_from.path_, kMaxSourcePathSize) != 0
+        || source_files[i].size_ != built_from.size_ || source_files[i].modified_time_ != built_from.modified_time_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Snapshot::Layout Snapshot::getLayout(const Header& header) {
+  Layout layout;
+  layout.stations_ = sizeof(Header);
+  layout.offsets_ = layout.stations_ + alignSection(header.num_verticies_ * sizeof(Graph::Station));
+  layout.neighbors_ = layout.offsets_ + alignSection((header.num_verticies_ + 1) * sizeof(uint32_t));
+  layout.weights_ = layout.neighbors_ + alignSection(header.num_adjacencies_ * sizeof(uint32_t));
+  layout.edges_ = layout.weights_ + alignSection(header.num_adjacencies_ * sizeof(double));
+  layout.source_files_ = layout.edges_ + alignSection(header.num_edges_ * sizeof(EdgeRecord));
+  layout.size_ = layout.source_files_ + alignSection(header.num_source_files_ * sizeof(SourceFile));
+  return layout;
+}
+
+uint64_t Snapshot::computeChecksum(const char* begin, const char* end) {
+  const uint64_t kOffsetBasis = 14695981039346656037ULL;
+  const uint64_t kPrime = 1099511628211ULL;
+  uint64_t checksum = kOffsetBasis;
+  const char* it = begin;
+  for (; end - it >= 8; it += 8) {
+    uint64_t word;
+    std::memcpy(&word, it, sizeof(word));
+    checksum = (checksum ^ word) * kPrime;
+  }
+  for (; it != end; ++it) {
+    checksum = (checksum ^ static_cast<unsigned char>(*it)) * kPrime;
+  }
+  return checksum;
+}
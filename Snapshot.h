@@ -0,0 +1,227 @@
+#pragma once
+
+#include "Graph.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class StaticGraph;
+
+/**
+ * Class representing a binary snapshot of a graph, memory mapped from a file
+ * A snapshot stores a station table, the graph's compressed sparse row adjacency (see
+ * StaticGraph) with its edge weights, and a table of the edges (with their trip statistics)
+ * The arrays are laid out so they can be used directly from the mapping, without parsing
+ *
+ * Layout (every section starts on an 8 byte boundary, numbers are in the host's byte order):
+ *    Header
+ *    Graph::Station[num_verticies_]      station of each vertex (sorted by station id)
+ *    uint32_t[num_verticies_ + 1]        offsets of each vertex's neighbors
+ *    uint32_t[num_adjacencies_]          neighbors of every vertex
+ *    double[num_adjacencies_]            weight of the edge to each neighbor
+ *    EdgeRecord[num_edges_]              every edge, in the order of the graph's edge list
+ *    SourceFile[num_source_files_]       the data files the graph was built from
+ */
+class Snapshot {
+  public:
+    // version of the layout (snapshots with any other version are not loaded)
+    static const uint32_t kVersion = 2;
+
+    // longest path of a source file that can be stored (including the null character)
+    static const size_t kMaxSourcePathSize = 256;
+
+    /**
+     * Struct storing the first bytes of a snapshot file
+     */
+    struct Header {
+      // identifies the file as a snapshot ("CBGRAPH" followed by a null character)
+      char magic_[8];
+      // version of the layout the file was written with
+      uint32_t version_;
+      // size of the header in bytes
+      uint32_t header_size_;
+      // number of verticies (stations)
+      uint64_t num_verticies_;
+      // number of neighbor entries (twice the number of edges)
+      uint64_t num_adjacencies_;
+      // number of edges
+      uint64_t num_edges_;
+      // combined weight of all edges
+      double total_weight_;
+      // number of data files the graph was built from
+      uint64_t num_source_files_;
+      // checksum of every byte after the header
+      uint64_t checksum_;
+    };
+
+    /**
+     * Struct storing a data file a snapshot was built from, so a snapshot can be rebuilt when the
+     * data files change
+     */
+    struct SourceFile {
+      // path to the file, as it was given when the graph was built (padded with null characters)
+      char path_[kMaxSourcePathSize];
+      // size of the file in bytes
+      uint64_t size_;
+      // time the file was last modified (in seconds since the epoch)
+      int64_t modified_time_;
+    };
+
+    /**
+     * Struct storing an edge of the graph
+     */
+    struct EdgeRecord {
+      // index of the start vertex of the edge (in the station table)
+      uint32_t start_vertex_;
+      // index of the end vertex of the edge (in the station table)
+      uint32_t end_vertex_;
+      // statistics about the trips taken along the edge
+      Graph::EdgeStats stats_;
+    };
+
+    /**
+     * Writes a snapshot file
+     * The file is written next to the given path and then renamed, so readers never see
+     * a partly written snapshot
+     *
+     * @param file_path a string representing the path to write the snapshot to
+     * @param graph the StaticGraph storing the stations and adjacency to write
+     * @param edges the edges to write (indices are verticies of graph)
+     * @param source_files the data files the graph was built from (see findSourceFiles)
+     * @return true if the snapshot was written
+     */
+    static bool write(const std::string& file_path, const StaticGraph& graph, const std::vector<EdgeRecord>& edges,
+        const std::vector<SourceFile>& source_files);
+
+    /**
+     * Looks up the size and modification time of data files (files that don't exist are left out)
+     *
+     * @param file_paths the paths to the data files
+     * @param source_files pointer to a vector to write a SourceFile for each file that exists into
+     * @return true if every path of a file that exists fits in a SourceFile
+     */
+    static bool findSourceFiles(const std::vector<std::string>& file_paths, std::vector<SourceFile>* source_files);
+
+    /**
+     * Computes the checksum of some bytes (64 bit FNV-1a, eight bytes at a time)
+     * Also used to check the other files saved next to a snapshot (see Landmarks)
+     *
+     * @param begin pointer to the first byte
+     * @param end pointer to one past the last byte
+     * @return the checksum
+     */
+    static uint64_t computeChecksum(const char* begin, const char* end);
+
+    /**
+     * Maps and checks a snapshot file
+     *
+     * @param file_path a string representing the path to the snapshot
+     */
+    explicit Snapshot(const std::string& file_path);
+
+    // the mapping can't be shared between objects
+    Snapshot(const Snapshot& other) = delete;
+    Snapshot& operator=(const Snapshot& rhs) = delete;
+
+    /**
+     * Checks if the file is a complete snapshot of the current version with a matching checksum
+     *
+     * @return true if the snapshot can be used
+     */
+    bool isValid() const;
+
+    /**
+     * Retrieves the header of the snapshot (only meaningful if isValid())
+     *
+     * @return a reference to the header
+     */
+    const Header& getHeader() const;
+
+    /**
+     * Retrieves the station table (num_verticies_ stations)
+     *
+     * @return pointer to the first station in the mapping
+     */
+    const Graph::Station* getStations() const;
+
+    /**
+     * Retrieves the offsets of each vertex's neighbors (num_verticies_ + 1 offsets)
+     *
+     * @return pointer to the first offset in the mapping
+     */
+    const uint32_t* getOffsets() const;
+
+    /**
+     * Retrieves the neighbors of every vertex (num_adjacencies_ indices)
+     *
+     * @return pointer to the first neighbor in the mapping
+     */
+    const uint32_t* getNeighbors() const;
+
+    /**
+     * Retrieves the weight of the edge to each neighbor (num_adjacencies_ weights)
+     *
+     * @return pointer to the first weight in the mapping
+     */
+    const double* getWeights() const;
+
+    /**
+     * Retrieves the edge table (num_edges_ edges)
+     *
+     * @return pointer to the first edge in the mapping
+     */
+    const EdgeRecord* getEdges() const;
+
+    /**
+     * Retrieves the data files the snapshot was built from (num_source_files_ files)
+     *
+     * @return pointer to the first source file in the mapping
+     */
+    const SourceFile* getSourceFiles() const;
+
+    /**
+     * Checks if the snapshot was built from exactly the data files that exist now, unchanged (the
+     * same files, with the same sizes and modification times)
+     *
+     * @param file_paths the paths to the data files (files that don't exist are left out)
+     * @return true if the snapshot is valid and its source files match
+     */
+    bool isBuiltFrom(const std::vector<std::string>& file_paths) const;
+
+  private:
+    /**
+     * Struct storing where each section of a snapshot starts (in bytes from the start of the file)
+     */
+    struct Layout {
+      size_t stations_ = 0;
+      size_t offsets_ = 0;
+      size_t neighbors_ = 0;
+      size_t weights_ = 0;
+      size_t edges_ = 0;
+      size_t source_files_ = 0;
+      // size of the whole file
+      size_t size_ = 0;
+    };
+
+    /**
+     * Finds where each section of a snapshot with the given counts starts
+     *
+     * @param header the Header storing the number of verticies, adjacencies, edges and source files
+     * @return the Layout of the snapshot
+     */
+    static Layout getLayout(const Header& header);
+
+    // the mapped snapshot file
+    MappedFile file_;
+
+    // copy of the header of the file
+    Header header_;
+
+    // where each section of the file starts
+    Layout layout_;
+
+    // true if the file is a usable snapshot
+    bool is_valid_ = false;
+};
@@ -0,0 +1,180 @@
+#include "Snapshot.h"
+#include "StaticGraph.h"
+
+#include <algorithm>
+#include <utility>
+
+const uint32_t StaticGraph::kNoVertex;
+
+StaticGraph::StaticGraph(const StaticGraph& other) {
+  *this = other;
+}
+
+StaticGraph& StaticGraph::operator=(const StaticGraph& rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+  owned_stations_ = rhs.owned_stations_;
+  owned_offsets_ = rhs.owned_offsets_;
+  owned_neighbors_ = rhs.owned_neighbors_;
+  owned_weights_ = rhs.owned_weights_;
+  snapshot_ = rhs.snapshot_;
+  num_verticies_ = rhs.num_verticies_;
+  num_adjacencies_ = rhs.num_adjacencies_;
+  total_weight_ = rhs.total_weight_;
+  if (snapshot_ != nullptr) {
+    // the mapping is shared, so the arrays are the same
+    stations_ = rhs.stations_;
+    offsets_ = rhs.offsets_;
+    neighbors_ = rhs.neighbors_;
+    weights_ = rhs.weights_;
+  } else {
+    useOwnedArrays();
+  }
+  return *this;
+}
+
+bool StaticGraph::loadSnapshot(const std::string& file_path) {
+  std::shared_ptr<const Snapshot> snapshot = std::make_shared<const Snapshot>(file_path);
+  if (!snapshot->isValid()) {
+    return false;
+  }
+  owned_stations_.clear();
+  owned_offsets_.clear();
+  owned_neighbors_.clear();
+  owned_weights_.clear();
+  snapshot_ = snapshot;
+  stations_ = snapshot_->getStations();
+  offsets_ = snapshot_->getOffsets();
+  neighbors_ = snapshot_->getNeighbors();
+  weights_ = snapshot_->getWeights();
+  num_verticies_ = snapshot_->getHeader().num_verticies_;
+  num_adjacencies_ = snapshot_->getHeader().num_adjacencies_;
+  total_weight_ = snapshot_->getHeader().total_weight_;
+  return true;
+}
+
+bool StaticGraph::isMapped() const {
+  return snapshot_ != nullptr;
+}
+
+void StaticGraph::useOwnedArrays() {
+  stations_ = owned_stations_.data();
+  offsets_ = owned_offsets_.data();
+  neighbors_ = owned_neighbors_.data();
+  weights_ = owned_weights_.data();
+  num_verticies_ = owned_stations_.size();
+  num_adjacencies_ = owned_neighbors_.size();
+}
+
+size_t StaticGraph::size() const {
+  return num_verticies_;
+}
+
+size_t StaticGraph::getNumEdges() const {
+  return num_adjacencies_ / 2;
+}
+
+const Graph::Station& StaticGraph::getStation(uint32_t vertex) const {
+  return stations_[vertex];
+}
+
+uint32_t StaticGraph::getVertexIndex(int station_id) const {
+  // stations are sorted by id, so the index can be found with a binary search
+  const Graph::Station* stations_end = stations_ + num_verticies_;
+  const Graph::Station* station_iter = std::lower_bound(stations_, stations_end, station_id,
+      [](const Graph::Station& station, int id) { return station.id_ < id; });
+  if (station_iter == stations_end || station_iter->id_ != station_id) {
+    return kNoVertex;
+  }
+  return static_cast<uint32_t>(station_iter - stations_);
+}
+
+uint32_t StaticGraph::getDegree(uint32_t vertex) const {
+  return offsets_[vertex + 1] - offsets_[vertex];
+}
+
+const uint32_t* StaticGraph::getNeighbors(uint32_t vertex) const {
+  return neighbors_ + offsets_[vertex];
+}
+
+const double* StaticGraph::getWeights(uint32_t vertex) const {
+  return weights_ + offsets_[vertex];
+}
+
+double StaticGraph::getTotalWeight() const {
+  return total_weight_;
+}
+
+std::vector<uint32_t> StaticGraph::DFS(uint32_t start, size_t* num_connected_components) const {
+  std::vector<uint32_t> traversal;
+  traversal.reserve(size());
+  std::vector<bool> visited(size(), false);
+  std::vector<uint32_t> stack;
+  size_t num_components = 0;
+  // index of the next vertex to check when the stack runs out
+  uint32_t next_unexplored = 0;
+
+  if (size() > 0) {
+    visited[start] = true;
+    stack.push_back(start);
+    num_components = 1;
+  }
+  while (!stack.empty()) {
+    uint32_t current_vertex = stack.back();
+    stack.pop_back();
+    traversal.push_back(current_vertex);
+
+    const uint32_t* neighbors = getNeighbors(current_vertex);
+    for (uint32_t i = 0; i < getDegree(current_vertex); ++i) {
+      if (!visited[neighbors[i]]) {
+        visited[neighbors[i]] = true;
+        stack.push_back(neighbors[i]);
+      }
+    }
+
+    // start the next connected component from the unexplored vertex with the smallest station id
+    if (stack.empty()) {
+      while (next_unexplored < size() && visited[next_unexplored]) {
+        ++next_unexplored;
+      }
+      if (next_unexplored < size()) {
+        visited[next_unexplored] = true;
+        stack.push_back(next_unexplored);
+        num_components += 1;
+      }
+    }
+  }
+
+  if (num_connected_components != nullptr) {
+    *num_connected_components = num_components;
+  }
+  return traversal;
+}
+
+size_t StaticGraph::getNumConnectedComponents() const {
+  size_t num_connected_components = 0;
+  DFS(0, &num_connected_components);
+  return num_connected_components;
+}
+
+bool StaticGraph::isConnected() const {
+  return getNumConnectedComponents() == 1;
+}
+
+int StaticGraph::isEulerian() const {
+  // unconnected graph is not Eulerian
+  if (!isConnected()) return 0;
+
+  // count number of vertices with odd degree
+  int odd_count = 0;
+  for (uint32_t vertex = 0; vertex < size(); ++vertex) {
+    if (getDegree(vertex) % 2 == 1) {
+      ++odd_count;
+    }
+  }
+
+  if (odd_count > 2) return 0;
+  if (odd_count == 2) return 1;
+  return 2;
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Snapshot;
+
+/**
+ * Class representing a frozen (read-only) copy of a Graph in compressed sparse row (CSR) form
+ * Verticies are numbered 0 to size() - 1 in order of station id, and the neighbors and edge
+ * weights of every vertex are stored contiguously, so traversals don't chase pointers
+ * Each undirected edge is stored once in the adjacency of each of its verticies
+ * A StaticGraph either owns its arrays, or uses the arrays of a memory mapped snapshot in place
+ */
+class StaticGraph {
+  public:
+    // vertex index used for a missing vertex (for example, the previous vertex of the start)
+    static const uint32_t kNoVertex = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Default Constructor (an empty graph)
+     */
+    StaticGraph() {}
+
+    /**
+     * Builds a frozen copy of a Graph
+     *
+     * @tparam WeightFunction the weight function used to precompute edge weights (see Graph::Dijkstras)
+     * @param graph the Graph to copy
+     * @param weight the weight function to use for edges
+     */
+    template <typename WeightFunction = Graph::GeometricDistance>
+    explicit StaticGraph(const Graph& graph, WeightFunction weight = WeightFunction());
+
+    /**
+     * Copy Constructor
+     * Copies of a graph loaded from a snapshot share the mapping
+     *
+     * @param to_copy a reference to a StaticGraph to create a new StaticGraph from
+     */
+    StaticGraph(const StaticGraph& to_copy);
+
+    StaticGraph& operator=(const StaticGraph& rhs);
+
+    /**
+     * Replaces the graph with the graph stored in a snapshot file (see Graph::saveSnapshot)
+     * The file is memory mapped and its arrays are used in place (nothing is parsed or copied)
+     * The edge weights are the ones the snapshot was written with (distances between stations)
+     *
+     * @param file_path a string representing the path to the snapshot
+     * @return true if the snapshot was loaded (if false, the graph is unchanged)
+     */
+    bool loadSnapshot(const std::string& file_path);
+
+    /**
+     * Checks if the graph's arrays are in a memory mapped snapshot
+     *
+     * @return true if the graph was loaded from a snapshot
+     */
+    bool isMapped() const;
+
+    /**
+     * Retrieves the number of verticies in the graph
+     *
+     * @return a size_t representing the number of verticies in the graph
+     */
+    size_t size() const;
+
+    /**
+     * Retrieves the number of (undirected) edges in the graph
+     *
+     * @return a size_t representing the number of edges in the graph
+     */
+    size_t getNumEdges() const;
+
+    /**
+     * Retrieves the station of a vertex
+     *
+     * @param vertex the index of the vertex
+     * @return the Station the vertex represents
+     */
+    const Graph::Station& getStation(uint32_t vertex) const;
+
+    /**
+     * Retrieves the index of the vertex of a station
+     *
+     * @param station_id the id of the station
+     * @return the index of the vertex representing the station (kNoVertex if there is none)
+     */
+    uint32_t getVertexIndex(int station_id) const;
+
+    /**
+     * Retrieves the number of edges adjacent to a vertex
+     *
+     * @param vertex the index of the vertex
+     * @return the degree of the vertex
+     */
+    uint32_t getDegree(uint32_t vertex) const;
+
+    /**
+     * Retrieves the neighbors of a vertex
+     *
+     * @param vertex the index of the vertex
+     * @return pointer to the first of getDegree(vertex) neighbor indices
+     */
+    const uint32_t* getNeighbors(uint32_t vertex) const;
+
+    /**
+     * Retrieves the weights of the edges to the neighbors of a vertex
+     *
+     * @param vertex the index of the vertex
+     * @return pointer to the first of getDegree(vertex) weights (in the same order as getNeighbors)
+     */
+    const double* getWeights(uint32_t vertex) const;
+
+    /**
+     * Retrieves the combined weight of all edges in the graph
+     *
+     * @return the combined weight of all edges in the graph
+     */
+    double getTotalWeight() const;
+
+    /**
+     * Traverses the graph depth first, in the same order as a DFS over the Graph it was built from
+     * Verticies that are not connected to the start are traversed afterwards (in order of station id)
+     *
+     * @param start the index of the vertex to start from
+     * @param num_connected_components pointer to write the number of connected components into
+     *    (may be nullptr)
+     * @return the indices of the verticies in the order they were traversed
+     */
+    std::vector<uint32_t> DFS(uint32_t start, size_t* num_connected_components) const;
+
+    /**
+     * Counts the connected components of the graph
+     *
+     * @return the number of connected components (0 for an empty graph)
+     */
+    size_t getNumConnectedComponents() const;
+
+    /**
+     * Determines if graph is connected
+     *
+     * @return true if the graph is connected, false otherwise
+     */
+    bool isConnected() const;
+
+    /**
+     * Determines if the graph is not Eulerian, or if the graph has a Eulerian path or cycle
+     *
+     * @return 0 if not Eulerian, 1 if has a Eulerian path, 2 if has a Eulerian cycle
+     */
+    int isEulerian() const;
+
+    /**
+     * Finds the shortest distance from a vertex to every vertex using Dijkstras Algorithm
+     *
+     * @tparam Heap the priority queue of verticies (DaryHeap, LazyBinaryHeap or FibonacciHeap,
+     *    see VertexHeap.h)
+     * @param start the index of the vertex to start from
+     * @param distances pointer to a vector to write the distance to each vertex into (infinity
+     *    if unreachable)
+     * @param previous pointer to a vector to write the previous vertex on the shortest path to
+     *    each vertex into (kNoVertex for the start and unreachable verticies)
+     */
+    template <typename Heap = DaryHeap<4>>
+    void Dijkstras(uint32_t start, std::vector<double>* distances, std::vector<uint32_t>* previous) const;
+
+  private:
+    /**
+     * Points the arrays at the arrays the graph owns
+     */
+    void useOwnedArrays();
+
+    // station of each vertex (sorted by station id)
+    const Graph::Station* stations_ = nullptr;
+
+    // index of the first neighbor of each vertex (with one extra entry at the end)
+    const uint32_t* offsets_ = nullptr;
+
+    // neighbors of every vertex (the neighbors of vertex v are at offsets_[v] to offsets_[v + 1])
+    const uint32_t* neighbors_ = nullptr;
+
+    // weight of the edge to each neighbor in neighbors_
+    const double* weights_ = nullptr;
+
+    // number of verticies in the graph
+    size_t num_verticies_ = 0;
+
+    // number of entries in neighbors_ (twice the number of edges)
+    size_t num_adjacencies_ = 0;
+
+    // combined weight of all edges in the graph
+    double total_weight_ = 0;
+
+    // storage of the arrays when the graph was built from a Graph (empty when mapped)
+    std::vector<Graph::Station> owned_stations_;
+    std::vector<uint32_t> owned_offsets_;
+    std::vector<uint32_t> owned_neighbors_;
+    std::vector<double> owned_weights_;
+
+    // the snapshot the arrays are in (nullptr when the graph owns its arrays)
+    std::shared_ptr<const Snapshot> snapshot_;
+};
+
+#include "StaticGraph.hpp"
@@ -0,0 +1,67 @@
+/**
+ * Definitions of the StaticGraph's template member functions
+ * (included at the bottom of StaticGraph.h)
+ */
+
+template <typename WeightFunction>
+StaticGraph::StaticGraph(const Graph& graph, WeightFunction weight) {
+  std::vector<Graph::VertexData*> sorted_verticies = graph.getVerticiesById();
+  owned_stations_.reserve(sorted_verticies.size());
+  for (Graph::VertexData* vertex : sorted_verticies) {
+    owned_stations_.push_back(vertex->station_);
+  }
+
+  // translate the Graph's dense vertex indices into this graph's indices (in order of station id)
+  std::vector<uint32_t> static_indices(sorted_verticies.size());
+  for (uint32_t static_index = 0; static_index < sorted_verticies.size(); ++static_index) {
+    static_indices[sorted_verticies[static_index]->index_] = static_index;
+  }
+
+  owned_offsets_.reserve(sorted_verticies.size() + 1);
+  owned_neighbors_.reserve(2 * graph.getNumEdges());
+  owned_weights_.reserve(2 * graph.getNumEdges());
+  owned_offsets_.push_back(0);
+  for (Graph::VertexData* vertex : sorted_verticies) {
+    // keep the order of the adjacency list so traversals visit verticies in the same order
+    for (Graph::Edge* edge : vertex->adjacent_edges_) {
+      double edge_weight = weight(edge);
+      owned_neighbors_.push_back(static_indices[edge->getOtherVertex(vertex)->index_]);
+      owned_weights_.push_back(edge_weight);
+      // each edge is in two adjacency lists, so only count it from its start vertex
+      if (edge->start_vertex_ == vertex) {
+        total_weight_ += edge_weight;
+      }
+    }
+    owned_offsets_.push_back(static_cast<uint32_t>(owned_neighbors_.size()));
+  }
+  useOwnedArrays();
+}
+
+template <typename Heap>
+void StaticGraph::Dijkstras(uint32_t start, std::vector<double>* distances, std::vector<uint32_t>* previous) const {
+  distances->assign(size(), std::numeric_limits<double>::infinity());
+  previous->assign(size(), kNoVertex);
+
+  Heap priority_queue;
+  priority_queue.reset(size());
+  (*distances)[start] = 0;
+  priority_queue.push(start, 0);
+
+  while (!priority_queue.empty()) {
+    uint32_t current_vertex = priority_queue.pop();
+    double current_distance = (*distances)[current_vertex];
+
+    const uint32_t* neighbors = getNeighbors(current_vertex);
+    const double* weights = getWeights(current_vertex);
+    for (uint32_t i = 0; i < getDegree(current_vertex); ++i) {
+      double new_distance = current_distance + weights[i];
+      // update vertex if this distance is smaller (but not if it is equal), which can't happen
+      // for a vertex that was already popped
+      if (new_distance < (*distances)[neighbors[i]]) {
+        (*distances)[neighbors[i]] = new_distance;
+        (*previous)[neighbors[i]] = current_vertex;
+        priority_queue.push(neighbors[i], new_distance);
+      }
+    }
+  }
+}
@@ -0,0 +1,68 @@
+#include "VertexHeap.h"
+
+#include <algorithm>
+#include <functional>
+
+void LazyBinaryHeap::reset(size_t num_verticies) {
+  entries_.clear();
+  is_popped_.assign(num_verticies, false);
+}
+
+bool LazyBinaryHeap::empty() {
+  // entries of popped verticies are stale (the vertex was popped with a smaller key)
+  while (!entries_.empty() && is_popped_[entries_.front().second]) {
+    std::pop_heap(entries_.begin(), entries_.end(), std::greater<std::pair<double, uint32_t>>());
+    entries_.pop_back();
+  }
+  return entries_.empty();
+}
+
+void LazyBinaryHeap::push(uint32_t vertex, double key) {
+  entries_.push_back(std::make_pair(key, vertex));
+  std::push_heap(entries_.begin(), entries_.end(), std::greater<std::pair<double, uint32_t>>());
+}
+
+uint32_t LazyBinaryHeap::pop() {
+  // skip stale entries (empty() has usually dropped them already)
+  empty();
+  uint32_t vertex = entries_.front().second;
+  std::pop_heap(entries_.begin(), entries_.end(), std::greater<std::pair<double, uint32_t>>());
+  entries_.pop_back();
+  is_popped_[vertex] = true;
+  return vertex;
+}
+
+double LazyBinaryHeap::minKey() {
+  empty();
+  return entries_.front().first;
+}
+
+void FibonacciHeap::reset(size_t num_verticies) {
+  heap_.clear();
+  handles_.assign(num_verticies, Heap::handle_type());
+  is_in_heap_.assign(num_verticies, false);
+}
+
+bool FibonacciHeap::empty() const {
+  return heap_.empty();
+}
+
+void FibonacciHeap::push(uint32_t vertex, double key) {
+  if (is_in_heap_[vertex]) {
+    heap_.update(handles_[vertex], std::make_pair(key, vertex));
+  } else {
+    handles_[vertex] = heap_.push(std::make_pair(key, vertex));
+    is_in_heap_[vertex] = true;
+  }
+}
+
+uint32_t FibonacciHeap::pop() {
+  uint32_t vertex = heap_.top().second;
+  heap_.pop();
+  is_in_heap_[vertex] = false;
+  return vertex;
+}
+
+double FibonacciHeap::minKey() const {
+  return heap_.top().first;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <boost/heap/fibonacci_heap.hpp>
+
+/**
+ * Priority queues of dense vertex indices keyed by distance, for Dijkstras
+ * Every heap has the same interface, so the heap can be chosen by template parameter:
+ *    reset(num_verticies): empties the heap, which then accepts verticies 0 to num_verticies - 1
+ *    empty(): true if there are no verticies left to pop
+ *    push(vertex, key): adds a vertex, or lowers its key if it is already in the heap
+ *    pop(): removes and returns the vertex with the smallest key
+ *    minKey(): the smallest key in the heap (only called when the heap is not empty)
+ * Verticies are only added when they are discovered (not all up front), and a vertex that has
+ * been popped must not be pushed again
+ */
+
+/**
+ * Indexed d-ary heap stored in flat arrays
+ * The position of every vertex in the heap is tracked, so lowering a key moves the vertex up in
+ * place instead of adding another entry
+ * A wider heap is shallower, so pushes and decreases do fewer moves and each pop compares
+ * children that sit next to each other in memory
+ *
+ * @tparam Arity the number of children of each node (4 by default)
+ */
+template <size_t Arity = 4>
+class DaryHeap {
+  public:
+    void reset(size_t num_verticies);
+    // empties the heap without changing the verticies it accepts (only touches the verticies left in it)
+    void clear();
+    bool empty() const;
+    void push(uint32_t vertex, double key);
+    uint32_t pop();
+    double minKey() const;
+
+  private:
+    // position used for verticies that are not in the heap
+    static const uint32_t kNotInHeap = UINT32_MAX;
+
+    /**
+     * Moves the entry at the given position up until its parent's key is not larger
+     */
+    void siftUp(size_t position);
+
+    /**
+     * Moves the entry at the given position down until none of its children's keys are smaller
+     */
+    void siftDown(size_t position);
+
+    // (key, vertex) entries in heap order
+    std::vector<std::pair<double, uint32_t>> entries_;
+
+    // position of each vertex in entries_ (kNotInHeap if it is not in the heap)
+    std::vector<uint32_t> positions_;
+};
+
+/**
+ * Binary heap with lazy deletion
+ * Lowering a key adds another entry instead of moving the old one, and entries of verticies that
+ * were already popped are skipped, so the heap may hold more entries than verticies
+ */
+class LazyBinaryHeap {
+  public:
+    void reset(size_t num_verticies);
+    // also drops stale entries from the top of the heap
+    bool empty();
+    void push(uint32_t vertex, double key);
+    uint32_t pop();
+    // also drops stale entries from the top of the heap
+    double minKey();
+
+  private:
+    // (key, vertex) entries in min heap order
+    std::vector<std::pair<double, uint32_t>> entries_;
+
+    // whether each vertex has been popped
+    std::vector<bool> is_popped_;
+};
+
+/**
+ * Boost fibonacci heap (the heap Dijkstras used originally), kept for comparison
+ * The handle of each vertex is stored in a flat array instead of in the vertex
+ */
+class FibonacciHeap {
+  public:
+    void reset(size_t num_verticies);
+    bool empty() const;
+    void push(uint32_t vertex, double key);
+    uint32_t pop();
+    double minKey() const;
+
+  private:
+    // orders entries so the smallest key is at the top
+    struct CompareEntries {
+      bool operator()(const std::pair<double, uint32_t>& one, const std::pair<double, uint32_t>& two) const {
+        return one.first > two.first;
+      }
+    };
+
+    typedef boost::heap::fibonacci_heap<std::pair<double, uint32_t>, boost::heap::compare<CompareEntries>> Heap;
+
+    // (key, vertex) entries
+    Heap heap_;
+
+    // handle of each vertex in the heap
+    std::vector<Heap::handle_type> handles_;
+
+    // whether each vertex is in the heap
+    std::vector<bool> is_in_heap_;
+};
+
+#include "VertexHeap.hpp"
@@ -0,0 +1,97 @@
+/**
+ * Definitions of the DaryHeap's member functions
+ * (included at the bottom of VertexHeap.h)
+ */
+
+template <size_t Arity>
+const uint32_t DaryHeap<Arity>::kNotInHeap;
+
+template <size_t Arity>
+void DaryHeap<Arity>::reset(size_t num_verticies) {
+  entries_.clear();
+  positions_.assign(num_verticies, kNotInHeap);
+}
+
+template <size_t Arity>
+void DaryHeap<Arity>::clear() {
+  for (const std::pair<double, uint32_t>& entry : entries_) {
+    positions_[entry.second] = kNotInHeap;
+  }
+  entries_.clear();
+}
+
+template <size_t Arity>
+bool DaryHeap<Arity>::empty() const {
+  return entries_.empty();
+}
+
+template <size_t Arity>
+void DaryHeap<Arity>::push(uint32_t vertex, double key) {
+  uint32_t position = positions_[vertex];
+  if (position == kNotInHeap) {
+    position = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(std::make_pair(key, vertex));
+    positions_[vertex] = position;
+  } else {
+    entries_[position].first = key;
+  }
+  siftUp(position);
+}
+
+template <size_t Arity>
+uint32_t DaryHeap<Arity>::pop() {
+  uint32_t vertex = entries_.front().second;
+  positions_[vertex] = kNotInHeap;
+  if (entries_.size() > 1) {
+    entries_.front() = entries_.back();
+    positions_[entries_.front().second] = 0;
+    entries_.pop_back();
+    siftDown(0);
+  } else {
+    entries_.pop_back();
+  }
+  return vertex;
+}
+
+template <size_t Arity>
+double DaryHeap<Arity>::minKey() const {
+  return entries_.front().first;
+}
+
+template <size_t Arity>
+void DaryHeap<Arity>::siftUp(size_t position) {
+  std::pair<double, uint32_t> entry = entries_[position];
+  while (position > 0) {
+    size_t parent = (position - 1) / Arity;
+    if (entries_[parent].first <= entry.first) break;
+    entries_[position] = entries_[parent];
+    positions_[entries_[position].second] = static_cast<uint32_t>(position);
+    position = parent;
+  }
+  entries_[position] = entry;
+  positions_[entry.second] = static_cast<uint32_t>(position);
+}
+
+template <size_t Arity>
+void DaryHeap<Arity>::siftDown(size_t position) {
+  std::pair<double, uint32_t> entry = entries_[position];
+  size_t size = entries_.size();
+  while (true) {
+    size_t first_child = position * Arity + 1;
+    if (first_child >= size) break;
+    // find the child with the smallest key
+    size_t last_child = std::min(first_child + Arity, size);
+    size_t smallest_child = first_child;
+    for (size_t child = first_child + 1; child < last_child; ++child) {
+      if (entries_[child].first < entries_[smallest_child].first) {
+        smallest_child = child;
+      }
+    }
+    if (entries_[smallest_child].first >= entry.first) break;
+    entries_[position] = entries_[smallest_child];
+    positions_[entries_[position].second] = static_cast<uint32_t>(position);
+    position = smallest_child;
+  }
+  entries_[position] = entry;
+  positions_[entry.second] = static_cast<uint32_t>(position);
+}
@@ -0,0 +1,1241 @@
+#include "../CSVScanner.h"
+#include "../CSVScanner.cpp"
+#include "../ContractionHierarchy.h"
+#include "../ContractionHierarchy.cpp"
+#include "../DFS.h"
+#include "../DFS.cpp"
+#include "../DisjointSet.h"
+#include "../DisjointSet.cpp"
+#include "../Graph.h"
+#include "../Graph.cpp"
+#include "../Landmarks.h"
+#include "../Landmarks.cpp"
+#include "../MappedFile.h"
+#include "../MappedFile.cpp"
+#include "../Snapshot.h"
+#include "../Snapshot.cpp"
+#include "../StaticGraph.h"
+#include "../StaticGraph.cpp"
+#include "../VertexHeap.h"
+#include "../VertexHeap.cpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <glob.h>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Benchmarks for the graph
+ * To compile and run all benchmarks:
+ *    make bench
+ *    ./bench
+ * To run only some of the benchmarks, pass their names (for example, ./bench loading)
+ */
+
+// number of times each benchmark is repeated (the fastest run is reported)
+const int kNumRuns = 5;
+
+// number of calls to operator new, and the bytes they asked for (see countAllocations)
+std::atomic<size_t> num_allocations(0);
+std::atomic<size_t> num_allocated_bytes(0);
+
+/**
+ * Global operator new and delete, replaced so benchmarks can count the memory a call allocates
+ * (delete is kept out of line, or gcc warns that memory from new is passed to free)
+ */
+void* operator new(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  num_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+  operator delete(memory);
+}
+
+/**
+ * Retrieves the paths to every data file in the data folder
+ *
+ * @return a vector of strings representing the paths to the data files
+ */
+std::vector<std::string> getDataFilePaths() {
+  std::vector<std::string> file_paths;
+  glob_t matches;
+  if (glob("data/*.csv", 0, nullptr, &matches) == 0) {
+    for (size_t i = 0; i < matches.gl_pathc; ++i) {
+      file_paths.push_back(matches.gl_pathv[i]);
+    }
+  }
+  globfree(&matches);
+  return file_paths;
+}
+
+/**
+ * Builds a graph from every file in the data folder
+ *
+ * @param graph pointer to the graph to add the data to
+ */
+void loadAllData(Graph* graph) {
+  graph->addDataFromFiles(getDataFilePaths(), 0);
+}
+
+/**
+ * Builds a random connected graph with stations spread over a 1 by 1 degree square
+ * Every station is joined to the station before it (so the graph is connected), and the rest
+ * of the edges join stations that are close together in the list of stations
+ *
+ * @param graph pointer to the graph to add the stations and edges to
+ * @param num_verticies the number of stations to add
+ * @param num_edges the number of edges to add (at least num_verticies - 1)
+ * @param seed the seed for the random number generator
+ */
+void makeRandomGraph(Graph* graph, size_t num_verticies, size_t num_edges, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  for (size_t i = 0; i < num_verticies; ++i) {
+    graph->insertVertex(Graph::Station(static_cast<int>(i), 40 + coordinate(generator), -74 + coordinate(generator)));
+  }
+  for (size_t i = 1; i < num_verticies; ++i) {
+    graph->insertEdgeFromData(graph->getVertex(static_cast<int>(i - 1)), graph->getVertex(static_cast<int>(i)));
+  }
+  std::uniform_int_distribution<size_t> station(0, num_verticies - 1);
+  std::uniform_int_distribution<int> offset(2, 64);
+  for (size_t num_added = num_verticies - 1; num_added < num_edges;) {
+    Graph::VertexData* first = graph->getVertex(static_cast<int>(station(generator)));
+    Graph::VertexData* second = graph->getVertex((first->station_.id_ + offset(generator)) % num_verticies);
+    if (graph->getEdge(first, second) == nullptr) {
+      graph->insertEdge(first, second);
+      num_added += 1;
+    }
+  }
+}
+
+/**
+ * Builds a random street grid: stations on a square grid (moved slightly off the grid, like street
+ * corners), each joined to the stations next to it on the grid, with some of the grid's edges left
+ * out and some diagonal edges added
+ * Unlike makeRandomGraph, edges only join stations that are close together, like the station graph
+ *
+ * @param graph pointer to the graph to add the stations and edges to
+ * @param grid_size the number of stations along each side of the grid
+ * @param seed the seed for the random number generator
+ */
+void makeGridGraph(Graph* graph, size_t grid_size, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+  std::uniform_real_distribution<double> chance(0, 1);
+  const double kSpacing = 1.0 / grid_size;
+  for (size_t row = 0; row < grid_size; ++row) {
+    for (size_t column = 0; column < grid_size; ++column) {
+      graph->insertVertex(Graph::Station(static_cast<int>(row * grid_size + column),
+          40 + (row + jitter(generator)) * kSpacing, -74 + (column + jitter(generator)) * kSpacing));
+    }
+  }
+  for (size_t row = 0; row < grid_size; ++row) {
+    for (size_t column = 0; column < grid_size; ++column) {
+      Graph::VertexData* station = graph->getVertex(static_cast<int>(row * grid_size + column));
+      if (column + 1 < grid_size && chance(generator) < 0.9) {
+        graph->insertEdge(station, graph->getVertex(static_cast<int>(row * grid_size + column + 1)));
+      }
+      if (row + 1 < grid_size && chance(generator) < 0.9) {
+        graph->insertEdge(station, graph->getVertex(static_cast<int>((row + 1) * grid_size + column)));
+      }
+      if (row + 1 < grid_size && column + 1 < grid_size && chance(generator) < 0.1) {
+        graph->insertEdge(station, graph->getVertex(static_cast<int>((row + 1) * grid_size + column + 1)));
+      }
+    }
+  }
+}
+
+/**
+ * Times a function
+ *
+ * @param function the function to time
+ * @return the fastest time of kNumRuns calls to the function in seconds
+ */
+template <typename Function>
+double timeBest(Function function) {
+  double best_seconds = std::numeric_limits<double>::infinity();
+  for (int run = 0; run < kNumRuns; ++run) {
+    auto start_time = std::chrono::steady_clock::now();
+    function();
+    best_seconds = std::min(best_seconds,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+  }
+  return best_seconds;
+}
+
+/**
+ * Counts the allocations one call to a function makes
+ *
+ * @param function the function to call
+ * @param bytes pointer to write the number of bytes allocated into
+ * @return the number of calls to operator new
+ */
+template <typename Function>
+size_t countAllocations(Function function, size_t* bytes) {
+  size_t allocations_before = num_allocations.load();
+  size_t bytes_before = num_allocated_bytes.load();
+  function();
+  *bytes = num_allocated_bytes.load() - bytes_before;
+  return num_allocations.load() - allocations_before;
+}
+
+/**
+ * Compares reading each data file through std::getline with reading it from a memory mapping
+ */
+void benchmarkLoading() {
+  std::cout << std::left << std::setw(28) << "file" << std::setw(16) << "getline MB/s"
+      << std::setw(16) << "mmap MB/s" << std::endl;
+  for (const std::string& file_path : getDataFilePaths()) {
+    double best_buffered = 0;
+    double best_mapped = 0;
+    for (int run = 0; run < kNumRuns; ++run) {
+      Graph buffered;
+      best_buffered = std::max(best_buffered, buffered.addDataFromFile(file_path).getBytesPerSecond());
+      Graph mapped;
+      best_mapped = std::max(best_mapped, mapped.addDataFromMappedFile(file_path).getBytesPerSecond());
+    }
+    std::cout << std::setw(28) << file_path << std::setw(16) << best_buffered / 1e6
+        << std::setw(16) << best_mapped / 1e6 << std::endl;
+  }
+}
+
+/**
+ * Measures how reading the largest data file scales with the number of parsing threads
+ */
+void benchmarkParallelLoading() {
+  std::vector<std::string> file_paths = getDataFilePaths();
+  if (file_paths.empty()) return;
+  std::string largest_file;
+  size_t largest_size = 0;
+  for (const std::string& file_path : file_paths) {
+    MappedFile data_file(file_path, false);
+    if (data_file.size() > largest_size) {
+      largest_size = data_file.size();
+      largest_file = file_path;
+    }
+  }
+
+  std::cout << largest_file << " (" << std::thread::hardware_concurrency() << " cores)" << std::endl;
+  std::cout << std::left << std::setw(10) << "threads" << std::setw(12) << "ms" << std::setw(12)
+      << "MB/s" << std::setw(12) << "speedup" << std::endl;
+  double serial_seconds = 0;
+  for (size_t num_threads = 1; num_threads <= 16; num_threads *= 2) {
+    double best_seconds = std::numeric_limits<double>::infinity();
+    for (int run = 0; run < kNumRuns; ++run) {
+      Graph graph;
+      best_seconds = std::min(best_seconds, graph.addDataFromFile(largest_file, num_threads).seconds_);
+    }
+    if (num_threads == 1) serial_seconds = best_seconds;
+    std::cout << std::setw(10) << num_threads << std::setw(12) << best_seconds * 1e3 << std::setw(12)
+        << largest_size / best_seconds / 1e6 << std::setw(12) << serial_seconds / best_seconds << std::endl;
+  }
+}
+
+/**
+ * Inserts an edge after checking for a duplicate by copying and walking the adjacency list
+ * of the first vertex (how insertEdgeFromData worked before the edge index)
+ */
+void insertEdgeWithLinearScan(Graph* graph, Graph::VertexData* vertex_one, Graph::VertexData* vertex_two) {
+  if (vertex_one == vertex_two) {
+    return;
+  }
+  std::list<Graph::Edge*> vertex_one_edges = vertex_one->adjacent_edges_;
+  for (Graph::Edge* edge : vertex_one_edges) {
+    if (edge->getOtherVertex(vertex_one) == vertex_two) {
+      return;
+    }
+  }
+  graph->insertEdge(vertex_one, vertex_two);
+}
+
+/**
+ * Compares loading every data file with the edge index against a linear scan of the adjacency lists
+ */
+void benchmarkEdgeDeduplication() {
+  std::vector<std::string> file_paths = getDataFilePaths();
+
+  // parse the trips up front so only edge insertion is timed
+  std::vector<Graph::Trip> trips;
+  for (const std::string& file_path : file_paths) {
+    std::ifstream data_file(file_path);
+    std::string data;
+    std::getline(data_file, data);
+    Graph::Trip trip;
+    while (std::getline(data_file, data)) {
+      if (CSVScanner::parseTrip(data.data(), data.data() + data.size(), &trip)) {
+        trips.push_back(trip);
+      }
+    }
+  }
+
+  double best_linear = std::numeric_limits<double>::infinity();
+  double best_indexed = std::numeric_limits<double>::infinity();
+  size_t num_edges = 0;
+  for (int run = 0; run < kNumRuns; ++run) {
+    auto start_time = std::chrono::steady_clock::now();
+    Graph linear;
+    for (const Graph::Trip& trip : trips) {
+      linear.insertVertex(trip.start_station_);
+      linear.insertVertex(trip.end_station_);
+      insertEdgeWithLinearScan(&linear, linear.getVertex(trip.start_station_.id_),
+          linear.getVertex(trip.end_station_.id_));
+    }
+    auto middle_time = std::chrono::steady_clock::now();
+    Graph indexed;
+    for (const Graph::Trip& trip : trips) {
+      indexed.insertTrip(trip);
+    }
+    auto end_time = std::chrono::steady_clock::now();
+    best_linear = std::min(best_linear, std::chrono::duration<double>(middle_time - start_time).count());
+    best_indexed = std::min(best_indexed, std::chrono::duration<double>(end_time - middle_time).count());
+    num_edges = indexed.getEdgeList().size();
+  }
+
+  std::cout << file_paths.size() << " files, " << trips.size() << " trips, " << num_edges << " edges" << std::endl;
+  std::cout << "linear scan (before): " << best_linear * 1e3 << " ms" << std::endl;
+  std::cout << "edge index (after):   " << best_indexed * 1e3 << " ms" << std::endl;
+  std::cout << "speedup: " << best_linear / best_indexed << "x" << std::endl;
+}
+
+/**
+ * Times building the full dataset graph from parsed trips, copying it, and destroying each
+ */
+void benchmarkGraphLifetime() {
+  Graph full_data;
+  loadAllData(&full_data);
+  // one trip per edge rebuilds the same verticies and edges without reparsing the files
+  std::vector<Graph::Trip> trips;
+  for (Graph::Edge* edge : full_data.getEdgeList()) {
+    Graph::Trip trip;
+    trip.start_station_ = edge->start_vertex_->station_;
+    trip.end_station_ = edge->end_vertex_->station_;
+    trips.push_back(trip);
+  }
+
+  double best_build = std::numeric_limits<double>::infinity();
+  double best_destroy_built = std::numeric_limits<double>::infinity();
+  double best_copy = std::numeric_limits<double>::infinity();
+  double best_destroy_copy = std::numeric_limits<double>::infinity();
+  for (int run = 0; run < kNumRuns; ++run) {
+    auto start_time = std::chrono::steady_clock::now();
+    Graph* built = new Graph();
+    for (const Graph::Trip& trip : trips) {
+      built->insertTrip(trip);
+    }
+    auto built_time = std::chrono::steady_clock::now();
+    Graph* copied = new Graph(*built);
+    auto copied_time = std::chrono::steady_clock::now();
+    delete built;
+    auto destroyed_built_time = std::chrono::steady_clock::now();
+    delete copied;
+    auto end_time = std::chrono::steady_clock::now();
+    best_build = std::min(best_build, std::chrono::duration<double>(built_time - start_time).count());
+    best_copy = std::min(best_copy, std::chrono::duration<double>(copied_time - built_time).count());
+    best_destroy_built = std::min(best_destroy_built,
+        std::chrono::duration<double>(destroyed_built_time - copied_time).count());
+    best_destroy_copy = std::min(best_destroy_copy,
+        std::chrono::duration<double>(end_time - destroyed_built_time).count());
+  }
+
+  std::cout << full_data.size() << " verticies, " << trips.size() << " edges" << std::endl;
+  std::cout << "build:         " << best_build * 1e3 << " ms" << std::endl;
+  std::cout << "destroy built: " << best_destroy_built * 1e3 << " ms" << std::endl;
+  std::cout << "copy:          " << best_copy * 1e3 << " ms" << std::endl;
+  std::cout << "destroy copy:  " << best_destroy_copy * 1e3 << " ms" << std::endl;
+}
+
+/**
+ * Times Dijkstras with one kind of heap on a Graph and on its frozen copy, and prints a row
+ *
+ * @tparam Heap the heap to run Dijkstras with (see VertexHeap.h)
+ * @param graph_name the name of the graph to print
+ * @param heap_name the name of the heap to print
+ * @param graph pointer to the Graph to run Dijkstras on (nullptr to only time the frozen copy)
+ * @param frozen the frozen copy of the graph
+ */
+template <typename Heap>
+void timeDijkstrasWithHeap(const std::string& graph_name, const std::string& heap_name, Graph* graph,
+    const StaticGraph& frozen) {
+  std::cout << std::setw(28) << graph_name << std::setw(16) << heap_name << std::setw(16);
+  if (graph != nullptr) {
+    Graph::VertexData* start = graph->getVertexByIndex(0);
+    std::cout << timeBest([&]() { graph->Dijkstras<Graph::GeometricDistance, Heap>(start); }) * 1e3;
+  } else {
+    std::cout << "-";
+  }
+  std::vector<double> distances;
+  std::vector<uint32_t> previous;
+  std::cout << std::setw(16) << timeBest([&]() { frozen.Dijkstras<Heap>(0, &distances, &previous); }) * 1e3
+      << std::endl;
+}
+
+/**
+ * Compares the heaps Dijkstras can use, on the full dataset and on random graphs
+ * The largest random graph is only run on its frozen copy (the Graph version also builds the
+ * minimum spanning tree, which hides the heap)
+ */
+void benchmarkHeaps() {
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* full_data = new Graph();
+  loadAllData(full_data);
+  graphs.push_back(std::make_pair("all data files", full_data));
+  Graph* hundred_thousand = new Graph();
+  makeRandomGraph(hundred_thousand, 100000, 400000, 225);
+  graphs.push_back(std::make_pair("random (1e5 V, 4e5 E)", hundred_thousand));
+  Graph* million = new Graph();
+  makeRandomGraph(million, 1000000, 3000000, 225);
+  graphs.push_back(std::make_pair("random (1e6 V, 3e6 E)", million));
+
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(16) << "heap" << std::setw(16)
+      << "Graph ms" << std::setw(16) << "StaticGraph ms" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    StaticGraph frozen = named_graph.second->freeze();
+    Graph* graph = (named_graph.second == million) ? nullptr : named_graph.second;
+    if (graph == nullptr) {
+      // free the pointer graph before timing so only the frozen copy is in memory
+      delete named_graph.second;
+    }
+    timeDijkstrasWithHeap<FibonacciHeap>(named_graph.first, "fibonacci", graph, frozen);
+    timeDijkstrasWithHeap<LazyBinaryHeap>(named_graph.first, "lazy binary", graph, frozen);
+    timeDijkstrasWithHeap<DaryHeap<2>>(named_graph.first, "indexed 2-ary", graph, frozen);
+    timeDijkstrasWithHeap<DaryHeap<4>>(named_graph.first, "indexed 4-ary", graph, frozen);
+    timeDijkstrasWithHeap<DaryHeap<8>>(named_graph.first, "indexed 8-ary", graph, frozen);
+    delete graph;
+  }
+}
+
+/**
+ * Compares building the full dataset graph from the data files with loading it from a snapshot
+ */
+void benchmarkSnapshot() {
+  const std::string kSnapshotPath = "benchmarks/bench.snapshot";
+  Graph full_data;
+  loadAllData(&full_data);
+  if (!full_data.saveSnapshot(kSnapshotPath)) {
+    std::cout << "could not save " << kSnapshotPath << std::endl;
+    return;
+  }
+
+  double from_csv = timeBest([]() {
+    Graph graph;
+    loadAllData(&graph);
+  });
+  double graph_from_snapshot = timeBest([&]() {
+    Graph graph;
+    graph.loadSnapshot(kSnapshotPath);
+  });
+  double static_graph_from_snapshot = timeBest([&]() {
+    StaticGraph graph;
+    graph.loadSnapshot(kSnapshotPath);
+  });
+  std::remove(kSnapshotPath.c_str());
+
+  std::cout << "Graph from data files:      " << from_csv * 1e3 << " ms" << std::endl;
+  std::cout << "Graph from snapshot:        " << graph_from_snapshot * 1e3 << " ms" << std::endl;
+  std::cout << "StaticGraph from snapshot:  " << static_graph_from_snapshot * 1e3 << " ms" << std::endl;
+}
+
+/**
+ * Compares traversing the pointer based Graph with traversing its frozen (CSR) copy
+ */
+void benchmarkStaticGraph() {
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* full_data = new Graph();
+  loadAllData(full_data);
+  graphs.push_back(std::make_pair("all data files", full_data));
+  Graph* synthetic = new Graph();
+  makeRandomGraph(synthetic, 20000, 80000, 225);
+  graphs.push_back(std::make_pair("random (20000 V, 80000 E)", synthetic));
+
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(12) << "algorithm" << std::setw(16)
+      << "Graph ms" << std::setw(16) << "StaticGraph ms" << std::setw(10) << "speedup" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    Graph* graph = named_graph.second;
+    StaticGraph frozen = graph->freeze();
+    Graph::VertexData* start = graph->getVertexMap().begin()->second;
+
+    size_t num_traversed = 0;
+    double pointer_dfs = timeBest([&]() {
+      DFS traversal(graph, start);
+      for (auto it = traversal.begin(); it != traversal.end(); ++it) {
+        num_traversed += 1;
+      }
+    });
+    double frozen_dfs = timeBest([&]() {
+      num_traversed += frozen.DFS(0, nullptr).size();
+    });
+    std::cout << std::setw(28) << named_graph.first << std::setw(12) << "DFS" << std::setw(16)
+        << pointer_dfs * 1e3 << std::setw(16) << frozen_dfs * 1e3 << std::setw(10)
+        << pointer_dfs / frozen_dfs << std::endl;
+
+    double pointer_dijkstras = timeBest([&]() {
+      num_traversed += graph->Dijkstras(start).getParents().size();
+    });
+    std::vector<double> distances;
+    std::vector<uint32_t> previous;
+    double frozen_dijkstras = timeBest([&]() {
+      frozen.Dijkstras(0, &distances, &previous);
+      num_traversed += previous.size();
+    });
+    std::cout << std::setw(28) << named_graph.first << std::setw(12) << "Dijkstras" << std::setw(16)
+        << pointer_dijkstras * 1e3 << std::setw(16) << frozen_dijkstras * 1e3 << std::setw(10)
+        << pointer_dijkstras / frozen_dijkstras << std::endl;
+    delete graph;
+  }
+}
+
+/**
+ * Picks random pairs of stations to route between
+ *
+ * @param graph the graph to pick stations from
+ * @param num_pairs the number of pairs to pick
+ * @param seed the seed for the random number generator
+ * @return a vector of (source, target) pairs of verticies
+ */
+std::vector<std::pair<Graph::VertexData*, Graph::VertexData*>> makeRandomQueries(const Graph& graph, size_t num_pairs,
+    unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<uint32_t> vertex(0, static_cast<uint32_t>(graph.size() - 1));
+  std::vector<std::pair<Graph::VertexData*, Graph::VertexData*>> queries;
+  queries.reserve(num_pairs);
+  for (size_t i = 0; i < num_pairs; ++i) {
+    Graph::VertexData* source = graph.getVertexByIndex(vertex(generator));
+    queries.push_back(std::make_pair(source, graph.getVertexByIndex(vertex(generator))));
+  }
+  return queries;
+}
+
+/**
+ * Times answering every query with a point-to-point shortest path function
+ *
+ * @param queries the (source, target) pairs to route between
+ * @param query function taking a source and a target and returning the cost of the path
+ * @param total_cost pointer to add the cost of every reachable query into (so the queries
+ *    can be compared, and are not optimized away)
+ * @return the number of queries answered per second
+ */
+template <typename Query>
+double timeQueries(const std::vector<std::pair<Graph::VertexData*, Graph::VertexData*>>& queries, Query query,
+    double* total_cost) {
+  double seconds = timeBest([&]() {
+    *total_cost = 0;
+    for (const std::pair<Graph::VertexData*, Graph::VertexData*>& pair : queries) {
+      double cost = query(pair.first, pair.second);
+      if (!std::isinf(cost)) {
+        *total_cost += cost;
+      }
+    }
+  });
+  return queries.size() / seconds;
+}
+
+/**
+ * Compares the query throughput of the one sided shortestPath with bidirectionalShortestPath,
+ * over random pairs of stations on the full dataset and on a random graph
+ */
+void benchmarkBidirectional() {
+  const size_t kNumQueries = 1000;
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* full_data = new Graph();
+  loadAllData(full_data);
+  graphs.push_back(std::make_pair("all data files", full_data));
+  Graph* synthetic = new Graph();
+  makeRandomGraph(synthetic, 20000, 80000, 225);
+  graphs.push_back(std::make_pair("random (20000 V, 80000 E)", synthetic));
+
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(16) << "search" << std::setw(16)
+      << "queries/s" << std::setw(20) << "total cost" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    Graph* graph = named_graph.second;
+    std::vector<std::pair<Graph::VertexData*, Graph::VertexData*>> queries =
+        makeRandomQueries(*graph, kNumQueries, 225);
+    std::vector<Graph::VertexData*> path;
+
+    double total_cost = 0;
+    double one_sided = timeQueries(queries, [&](Graph::VertexData* source, Graph::VertexData* target) {
+      return graph->shortestPath(source, target, &path);
+    }, &total_cost);
+    std::cout << std::setw(28) << named_graph.first << std::setw(16) << "one sided" << std::setw(16)
+        << one_sided << std::setw(20) << std::setprecision(10) << total_cost << std::setprecision(6) << std::endl;
+
+    double bidirectional = timeQueries(queries, [&](Graph::VertexData* source, Graph::VertexData* target) {
+      return graph->bidirectionalShortestPath(source, target, &path);
+    }, &total_cost);
+    std::cout << std::setw(28) << named_graph.first << std::setw(16) << "bidirectional" << std::setw(16)
+        << bidirectional << std::setw(20) << std::setprecision(10) << total_cost << std::setprecision(6)
+        << std::endl;
+    delete graph;
+  }
+}
+
+/**
+ * Compares A* with the straight line heuristic to A* without a heuristic (Dijkstras) on the full
+ * dataset, over random pairs of stations and across the whole map
+ */
+void benchmarkAStar() {
+  const size_t kNumQueries = 1000;
+  Graph graph;
+  loadAllData(&graph);
+  std::vector<std::pair<Graph::VertexData*, Graph::VertexData*>> queries = makeRandomQueries(graph, kNumQueries, 225);
+  std::vector<Graph::VertexData*> path;
+
+  std::cout << std::left << std::setw(16) << "search" << std::setw(16) << "queries/s" << std::setw(20)
+      << "mean settled" << std::setw(20) << "settled NW to SE" << std::setw(20) << "total cost" << std::endl;
+  size_t num_settled = 0;
+  size_t total_settled = 0;
+  double total_cost = 0;
+  double dijkstras = timeQueries(queries, [&](Graph::VertexData* source, Graph::VertexData* target) {
+    double cost = graph.AStar<Graph::NoHeuristic>(source, target, &path, &num_settled);
+    total_settled += num_settled;
+    return cost;
+  }, &total_cost);
+  graph.AStar<Graph::NoHeuristic>(graph.getNorthwestMost(), graph.getSoutheastMost(), &path, &num_settled);
+  std::cout << std::setw(16) << "Dijkstras" << std::setw(16) << dijkstras << std::setw(20)
+      << static_cast<double>(total_settled) / (kNumRuns * kNumQueries) << std::setw(20) << num_settled
+      << std::setw(20) << std::setprecision(10) << total_cost << std::setprecision(6) << std::endl;
+
+  total_settled = 0;
+  double a_star = timeQueries(queries, [&](Graph::VertexData* source, Graph::VertexData* target) {
+    double cost = graph.AStar(source, target, &path, &num_settled);
+    total_settled += num_settled;
+    return cost;
+  }, &total_cost);
+  graph.AStar(graph.getNorthwestMost(), graph.getSoutheastMost(), &path, &num_settled);
+  std::cout << std::setw(16) << "A*" << std::setw(16) << a_star << std::setw(20)
+      << static_cast<double>(total_settled) / (kNumRuns * kNumQueries) << std::setw(20) << num_settled
+      << std::setw(20) << std::setprecision(10) << total_cost << std::setprecision(6) << std::endl;
+}
+
+/**
+ * Times each query separately and prints the latency percentiles
+ *
+ * @param graph_name the name of the graph to print
+ * @param search_name the name of the search to print
+ * @param queries the (source, target) pairs to route between
+ * @param query function taking a source and a target and returning the cost of the path
+ */
+template <typename Query>
+void printQueryLatencies(const std::string& graph_name, const std::string& search_name,
+    const std::vector<std::pair<Graph::VertexData*, Graph::VertexData*>>& queries, Query query) {
+  std::vector<double> latencies;
+  latencies.reserve(queries.size());
+  double total_cost = 0;
+  for (const std::pair<Graph::VertexData*, Graph::VertexData*>& pair : queries) {
+    auto start_time = std::chrono::steady_clock::now();
+    double cost = query(pair.first, pair.second);
+    latencies.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+    if (!std::isinf(cost)) {
+      total_cost += cost;
+    }
+  }
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << std::setw(28) << graph_name << std::setw(16) << search_name;
+  for (double percentile : {0.5, 0.9, 0.99, 1.0}) {
+    size_t position = std::min(latencies.size() - 1, static_cast<size_t>(percentile * latencies.size()));
+    std::cout << std::setw(12) << latencies[position] * 1e6;
+  }
+  std::cout << std::setw(20) << std::setprecision(10) << total_cost << std::setprecision(6) << std::endl;
+}
+
+/**
+ * Compares the query latency of Dijkstras, A* with the straight line heuristic, and A* with
+ * landmarks (ALT), over random pairs of stations on the full dataset and on a random graph
+ */
+void benchmarkLandmarks() {
+  const size_t kNumQueries = 2000;
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* full_data = new Graph();
+  loadAllData(full_data);
+  graphs.push_back(std::make_pair("all data files", full_data));
+  Graph* synthetic = new Graph();
+  makeRandomGraph(synthetic, 20000, 80000, 225);
+  graphs.push_back(std::make_pair("random (20000 V, 80000 E)", synthetic));
+
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    Graph* graph = named_graph.second;
+    auto start_time = std::chrono::steady_clock::now();
+    Landmarks landmarks(*graph, Landmarks::kDefaultNumLandmarks);
+    double preprocessing_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    std::cout << named_graph.first << ": " << landmarks.getNumLandmarks() << " landmarks picked in "
+        << preprocessing_seconds * 1e3 << " ms (" << graph->size() * landmarks.getNumLandmarks() * sizeof(float) / 1024
+        << " KB of tables)" << std::endl;
+  }
+
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(16) << "search" << std::setw(12) << "p50 us"
+      << std::setw(12) << "p90 us" << std::setw(12) << "p99 us" << std::setw(12) << "max us" << std::setw(20)
+      << "total cost" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    Graph* graph = named_graph.second;
+    Landmarks landmarks(*graph, Landmarks::kDefaultNumLandmarks);
+    std::vector<std::pair<Graph::VertexData*, Graph::VertexData*>> queries =
+        makeRandomQueries(*graph, kNumQueries, 225);
+    std::vector<Graph::VertexData*> path;
+    printQueryLatencies(named_graph.first, "Dijkstras", queries,
+        [&](Graph::VertexData* source, Graph::VertexData* target) {
+      return graph->shortestPath(source, target, &path);
+    });
+    printQueryLatencies(named_graph.first, "A*", queries, [&](Graph::VertexData* source, Graph::VertexData* target) {
+      return graph->AStar(source, target, &path, nullptr);
+    });
+    printQueryLatencies(named_graph.first, "A* landmarks", queries,
+        [&](Graph::VertexData* source, Graph::VertexData* target) {
+      return graph->AStar(source, target, &path, nullptr, landmarks.getHeuristic());
+    });
+    delete graph;
+  }
+}
+
+/**
+ * Times building a contraction hierarchy, and compares its query latency with Dijkstras and
+ * A* with landmarks, over random pairs of stations on the full dataset and on random graphs
+ */
+void benchmarkContractionHierarchy() {
+  const size_t kNumQueries = 2000;
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* full_data = new Graph();
+  loadAllData(full_data);
+  graphs.push_back(std::make_pair("all data files", full_data));
+  Graph* grid = new Graph();
+  makeGridGraph(grid, 100, 225);
+  graphs.push_back(std::make_pair("street grid (10000 V)", grid));
+  Graph* synthetic = new Graph();
+  makeRandomGraph(synthetic, 10000, 40000, 225);
+  graphs.push_back(std::make_pair("random (10000 V, 40000 E)", synthetic));
+
+  std::vector<ContractionHierarchy> hierarchies;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    auto start_time = std::chrono::steady_clock::now();
+    hierarchies.push_back(ContractionHierarchy(*named_graph.second));
+    double preprocessing_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    std::cout << named_graph.first << ": " << named_graph.second->size() << " verticies, "
+        << named_graph.second->getEdgeList().size() << " edges, " << hierarchies.back().getNumShortcuts()
+        << " shortcuts added in " << preprocessing_seconds * 1e3 << " ms" << std::endl;
+  }
+
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(16) << "search" << std::setw(12) << "p50 us"
+      << std::setw(12) << "p90 us" << std::setw(12) << "p99 us" << std::setw(12) << "max us" << std::setw(20)
+      << "total cost" << std::endl;
+  for (size_t i = 0; i < graphs.size(); ++i) {
+    Graph* graph = graphs[i].second;
+    const ContractionHierarchy& hierarchy = hierarchies[i];
+    Landmarks landmarks(*graph, Landmarks::kDefaultNumLandmarks);
+    std::vector<std::pair<Graph::VertexData*, Graph::VertexData*>> queries =
+        makeRandomQueries(*graph, kNumQueries, 225);
+    std::vector<Graph::VertexData*> path;
+    printQueryLatencies(graphs[i].first, "Dijkstras", queries,
+        [&](Graph::VertexData* source, Graph::VertexData* target) {
+      return graph->shortestPath(source, target, &path);
+    });
+    printQueryLatencies(graphs[i].first, "A* landmarks", queries,
+        [&](Graph::VertexData* source, Graph::VertexData* target) {
+      return graph->AStar(source, target, &path, nullptr, landmarks.getHeuristic());
+    });
+    ContractionHierarchy::QuerySearch query_search;
+    printQueryLatencies(graphs[i].first, "CH", queries, [&](Graph::VertexData* source, Graph::VertexData* target) {
+      return hierarchy.shortestPath(source, target, &path, nullptr, &query_search);
+    });
+    delete graph;
+  }
+}
+
+/**
+ * Times computing a distance matrix with 1 to 16 threads, on the full dataset (every station to
+ * every station) and on a random street grid (256 stations to every station)
+ */
+void benchmarkDistanceMatrix() {
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* full_data = new Graph();
+  loadAllData(full_data);
+  graphs.push_back(std::make_pair("all data files", full_data));
+  Graph* grid = new Graph();
+  makeGridGraph(grid, 100, 225);
+  graphs.push_back(std::make_pair("street grid (10000 V)", grid));
+
+  std::cout << std::thread::hardware_concurrency() << " cores" << std::endl;
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(16) << "matrix" << std::setw(10) << "threads"
+      << std::setw(12) << "ms" << std::setw(16) << "searches/s" << std::setw(12) << "speedup" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    Graph* graph = named_graph.second;
+    const std::vector<Graph::VertexData*>& targets = graph->getVertexList();
+    std::vector<Graph::VertexData*> sources(targets.begin(), targets.begin() + std::min<size_t>(256, targets.size()));
+    std::string matrix_size = std::to_string(sources.size()) + " x " + std::to_string(targets.size());
+
+    double serial_seconds = 0;
+    double total_distance = 0;
+    for (size_t num_threads = 1; num_threads <= 16; num_threads *= 2) {
+      double seconds = timeBest([&]() {
+        std::vector<double> matrix = graph->distanceMatrix(sources, targets, num_threads);
+        total_distance += matrix[matrix.size() / 2];
+      });
+      if (num_threads == 1) serial_seconds = seconds;
+      std::cout << std::setw(28) << named_graph.first << std::setw(16) << matrix_size << std::setw(10) << num_threads
+          << std::setw(12) << seconds * 1e3 << std::setw(16) << sources.size() / seconds << std::setw(12)
+          << serial_seconds / seconds << std::endl;
+    }
+    delete graph;
+  }
+}
+
+/**
+ * Compares the time and memory of one Dijkstras call returning a ShortestPathTree with building
+ * the result it used to return (a tree Graph and a map of previous verticies by station id, both
+ * copied into the returned pair)
+ */
+void benchmarkShortestPathTree() {
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* full_data = new Graph();
+  loadAllData(full_data);
+  graphs.push_back(std::make_pair("all data files", full_data));
+  Graph* random = new Graph();
+  makeRandomGraph(random, 20000, 80000, 225);
+  graphs.push_back(std::make_pair("random (20000 V, 80000 E)", random));
+
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(20) << "result" << std::setw(12) << "ms"
+      << std::setw(14) << "allocations" << std::setw(12) << "KB" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    Graph* graph = named_graph.second;
+    Graph::VertexData* start = graph->getVertexByIndex(0);
+
+    auto shortest_path_tree = [&]() {
+      return graph->Dijkstras(start);
+    };
+    auto graph_and_map = [&]() {
+      Graph::ShortestPathTree tree = graph->Dijkstras(start);
+      std::map<int, Graph::VertexData*> previous_verticies;
+      for (Graph::VertexData* vertex : graph->getVertexList()) {
+        previous_verticies.emplace(vertex->station_.id_, tree.getParent(vertex));
+      }
+      return std::make_pair(tree.toGraph(), previous_verticies);
+    };
+
+    size_t num_reached = 0;
+    auto time_tree = [&]() { num_reached += shortest_path_tree().getParents().size(); };
+    auto time_graph_and_map = [&]() { num_reached += graph_and_map().second.size(); };
+    size_t tree_bytes = 0;
+    size_t tree_allocations = countAllocations(time_tree, &tree_bytes);
+    size_t graph_bytes = 0;
+    size_t graph_allocations = countAllocations(time_graph_and_map, &graph_bytes);
+    std::cout << std::setw(28) << named_graph.first << std::setw(20) << "ShortestPathTree" << std::setw(12)
+        << timeBest(time_tree) * 1e3 << std::setw(14) << tree_allocations << std::setw(12) << tree_bytes / 1024
+        << std::endl;
+    std::cout << std::setw(28) << named_graph.first << std::setw(20) << "Graph + map" << std::setw(12)
+        << timeBest(time_graph_and_map) * 1e3 << std::setw(14) << graph_allocations << std::setw(12)
+        << graph_bytes / 1024 << std::endl;
+    delete graph;
+  }
+}
+
+/**
+ * Determines if a graph is connected with a full DFS traversal (how isConnected worked before the
+ * graph kept its connected components)
+ */
+bool isConnectedWithDFS(const Graph& graph) {
+  if (graph.size() == 0) return false;
+  DFS dfs = DFS(&graph, graph.getVertexByIndex(0));
+  for (auto it = dfs.begin(); it != dfs.end(); ++it) {
+    if (dfs.getNumConnectedComponents() != 1) return false;
+  }
+  return dfs.getNumConnectedComponents() == 1;
+}
+
+/**
+ * Times isConnected and getComponent for every station, read from the connected components kept
+ * while loading, against a DFS traversal, on the full dataset and on a random 20000 station graph
+ */
+void benchmarkConnectedComponents() {
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* full_data = new Graph();
+  loadAllData(full_data);
+  graphs.push_back(std::make_pair("all data files", full_data));
+  Graph* random = new Graph();
+  makeRandomGraph(random, 20000, 80000, 229);
+  graphs.push_back(std::make_pair("random (20000 V, 80000 E)", random));
+
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(32) << "query" << std::setw(12) << "ms"
+      << std::setw(12) << "result" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    const Graph& graph = *named_graph.second;
+    bool is_connected = false;
+    double dfs_seconds = timeBest([&]() { is_connected = isConnectedWithDFS(graph); });
+    std::cout << std::setw(28) << named_graph.first << std::setw(32) << "DFS isConnected" << std::setw(12)
+        << dfs_seconds * 1e3 << std::setw(12) << is_connected << std::endl;
+    double seconds = timeBest([&]() { is_connected = graph.isConnected(); });
+    std::cout << std::setw(28) << named_graph.first << std::setw(32) << "isConnected" << std::setw(12)
+        << seconds * 1e3 << std::setw(12) << is_connected << std::endl;
+    // each component's id is the index of one of its stations, so counting those counts the components
+    size_t num_components = 0;
+    seconds = timeBest([&]() {
+      num_components = 0;
+      for (Graph::VertexData* vertex : graph.getVertexList()) {
+        num_components += graph.getComponent(vertex) == vertex->index_;
+      }
+    });
+    std::cout << std::setw(28) << named_graph.first << std::setw(32) << "getComponent (every station)"
+        << std::setw(12) << seconds * 1e3 << std::setw(12) << num_components << std::endl;
+    delete named_graph.second;
+  }
+}
+
+/**
+ * Builds the graph of the stations closest to a station, with the edges of the full graph
+ * between them
+ *
+ * @param graph the graph to take the stations from
+ * @param center a pointer to the station to take the closest stations to (included)
+ * @param num_stations the number of stations to take
+ * @param neighborhood pointer to the (empty) Graph to build
+ */
+void makeNeighborhood(const Graph& graph, Graph::VertexData* center, size_t num_stations, Graph* neighborhood) {
+  std::vector<Graph::VertexData*> closest = graph.getVertexList();
+  Graph::StraightLineDistance distance;
+  std::sort(closest.begin(), closest.end(), [&](Graph::VertexData* one, Graph::VertexData* two) {
+    return distance(one, center) < distance(two, center);
+  });
+  closest.resize(std::min(num_stations, closest.size()));
+  for (Graph::VertexData* vertex : closest) {
+    neighborhood->insertVertex(vertex->station_);
+  }
+  for (Graph::VertexData* vertex : closest) {
+    for (Graph::VertexData* other : closest) {
+      if (vertex->station_.id_ < other->station_.id_ && graph.getEdge(vertex, other) != nullptr) {
+        neighborhood->insertEdge(neighborhood->getVertex(vertex->station_.id_), neighborhood->getVertex(other->station_.id_));
+      }
+    }
+  }
+}
+
+/**
+ * Times the Held-Karp solver for the largest hamiltonian cycle against the backtracking search on
+ * a small complete graph, and with 1 to 16 threads on neighborhoods of the full dataset and on
+ * complete graphs of up to 22 stations
+ */
+void benchmarkHeldKarp() {
+  std::mt19937 generator(225);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  auto makeCompleteGraph = [&](size_t num_verticies, Graph* graph) {
+    for (int id = 0; id < static_cast<int>(num_verticies); ++id) {
+      graph->insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+      for (int other = 0; other < id; ++other) {
+        graph->insertEdge(graph->getVertex(id), graph->getVertex(other));
+      }
+    }
+  };
+
+  std::vector<Graph::VertexData*> cycle;
+  Graph small;
+  makeCompleteGraph(10, &small);
+  std::cout << "complete graph (10 V): backtracking " << timeBest([&]() { small.getLargestHamiltonianCycle(); }) * 1e3
+      << " ms, Held-Karp " << timeBest([&]() { small.getLargestHamiltonianCycleHeldKarp(&cycle, 1); }) * 1e3
+      << " ms" << std::endl;
+
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph full_data;
+  loadAllData(&full_data);
+  for (size_t num_stations : {16, 20}) {
+    Graph* neighborhood = new Graph();
+    makeNeighborhood(full_data, full_data.getNorthwestMost(), num_stations, neighborhood);
+    graphs.push_back(std::make_pair(std::to_string(num_stations) + " stations of data", neighborhood));
+  }
+  for (size_t num_verticies : {16, 20, 22}) {
+    Graph* complete = new Graph();
+    makeCompleteGraph(num_verticies, complete);
+    graphs.push_back(std::make_pair("complete (" + std::to_string(num_verticies) + " V)", complete));
+  }
+
+  std::cout << std::thread::hardware_concurrency() << " cores" << std::endl;
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(10) << "threads" << std::setw(12) << "ms"
+      << std::setw(12) << "speedup" << std::setw(16) << "cycle weight" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    double serial_seconds = 0;
+    double cycle_weight = 0;
+    for (size_t num_threads = 1; num_threads <= 16; num_threads *= 2) {
+      double seconds = timeBest([&]() {
+        cycle_weight = named_graph.second->getLargestHamiltonianCycleHeldKarp(&cycle, num_threads);
+      });
+      if (num_threads == 1) serial_seconds = seconds;
+      std::cout << std::setw(28) << named_graph.first << std::setw(10) << num_threads << std::setw(12)
+          << seconds * 1e3 << std::setw(12) << serial_seconds / seconds << std::setw(16) << cycle_weight << std::endl;
+    }
+    delete named_graph.second;
+  }
+}
+
+/**
+ * Times the parallel branch and bound search for the largest hamiltonian cycle with 1 to 16 threads
+ * on neighborhoods of the full dataset and on complete graphs, and counts the paths it looks at
+ */
+void benchmarkHamiltonianSearch() {
+  std::mt19937 generator(226);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph full_data;
+  loadAllData(&full_data);
+  for (size_t num_stations : {12, 13}) {
+    Graph* neighborhood = new Graph();
+    makeNeighborhood(full_data, full_data.getNorthwestMost(), num_stations, neighborhood);
+    graphs.push_back(std::make_pair(std::to_string(num_stations) + " stations of data", neighborhood));
+  }
+  for (size_t num_verticies : {12, 13}) {
+    Graph* complete = new Graph();
+    for (int id = 0; id < static_cast<int>(num_verticies); ++id) {
+      complete->insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+      for (int other = 0; other < id; ++other) {
+        complete->insertEdge(complete->getVertex(id), complete->getVertex(other));
+      }
+    }
+    graphs.push_back(std::make_pair("complete (" + std::to_string(num_verticies) + " V)", complete));
+  }
+
+  std::vector<Graph::VertexData*> cycle;
+  std::cout << std::thread::hardware_concurrency() << " cores" << std::endl;
+  std::cout << std::left << std::setw(28) << "graph" << std::setw(10) << "threads" << std::setw(12) << "ms"
+      << std::setw(12) << "speedup" << std::setw(16) << "cycle weight" << std::setw(16) << "paths" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    double serial_seconds = 0;
+    double cycle_weight = 0;
+    size_t num_explored = 0;
+    for (size_t num_threads = 1; num_threads <= 16; num_threads *= 2) {
+      double seconds = timeBest([&]() {
+        cycle_weight = named_graph.second->findLargestHamiltonianCycle(&cycle, num_threads, &num_explored);
+      });
+      if (num_threads == 1) serial_seconds = seconds;
+      std::cout << std::setw(28) << named_graph.first << std::setw(10) << num_threads << std::setw(12)
+          << seconds * 1e3 << std::setw(12) << serial_seconds / seconds << std::setw(16) << cycle_weight
+          << std::setw(16) << num_explored << std::endl;
+    }
+    delete named_graph.second;
+  }
+}
+
+/**
+ * Extends a path through every neighbor of its last vertex, building a Graph of the path as it goes
+ * and copying it whenever it closes into a larger cycle (how getLargestHamiltonianCycle searched
+ * before it kept the path in flat arrays)
+ *
+ * @param vertex the last vertex of the path
+ * @param path the Graph of the path
+ * @param path_vertex the vertex of the path's Graph that is a copy of vertex
+ * @param start the first vertex of the path
+ * @param path_start the vertex of the path's Graph that is a copy of start
+ * @param num_verticies the number of verticies a hamiltonian cycle has
+ * @param is_visited whether each vertex is on the path, by index
+ * @param largest pointer to the Graph of the largest cycle found so far (nullptr if none)
+ */
+void extendPathGraph(Graph::VertexData* vertex, Graph* path, Graph::VertexData* path_vertex, Graph::VertexData* start,
+    Graph::VertexData* path_start, size_t num_verticies, std::vector<bool>* is_visited, Graph** largest) {
+  if (path->size() == num_verticies) {
+    if (vertex->isAdjacentVertex(start)) {
+      // the closing edge is removed with the path's last vertex
+      path->insertEdge(path_start, path_vertex);
+      if (*largest == nullptr || path->getTotalDistance() > (*largest)->getTotalDistance()) {
+        delete *largest;
+        *largest = new Graph(*path);
+      }
+    }
+  }
+  for (Graph::Edge* edge : vertex->adjacent_edges_) {
+    Graph::VertexData* other_vertex = edge->getOtherVertex(vertex);
+    if (!(*is_visited)[other_vertex->index_]) {
+      (*is_visited)[other_vertex->index_] = true;
+      Graph::VertexData* path_other_vertex = path->insertVertex(other_vertex->station_);
+      path->insertEdge(path_vertex, path_other_vertex);
+      extendPathGraph(other_vertex, path, path_other_vertex, start, path_start, num_verticies, is_visited, largest);
+      (*is_visited)[other_vertex->index_] = false;
+      path->removeVertex(path_other_vertex);
+    }
+  }
+}
+
+/**
+ * Times the search for the largest hamiltonian cycle on one thread against the search that builds
+ * a Graph of its path (see extendPathGraph) on the hamiltonian test graphs and on random graphs of
+ * 15 to 20 verticies, and counts the memory each one allocates
+ */
+void benchmarkHamiltonianPathState() {
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  for (const char* name : {"hamiltonian1", "hamiltonian2", "non_hamiltonian"}) {
+    Graph* test_graph = new Graph();
+    test_graph->addDataFromFile(std::string("tests/test_data/") + name + "_dat.csv");
+    graphs.push_back(std::make_pair(name, test_graph));
+  }
+  for (size_t num_verticies : {15, 18, 20}) {
+    Graph* random = new Graph();
+    makeRandomGraph(random, num_verticies, num_verticies * 5 / 2, 228);
+    graphs.push_back(std::make_pair("random (" + std::to_string(num_verticies) + " V)", random));
+  }
+
+  std::cout << std::left << std::setw(20) << "graph" << std::setw(14) << "search" << std::setw(12) << "ms"
+      << std::setw(12) << "speedup" << std::setw(14) << "allocations" << std::setw(16) << "cycle weight" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    const Graph& graph = *named_graph.second;
+    double graph_cycle_weight = 0;
+    auto search_with_graphs = [&]() {
+      Graph::VertexData* start = graph.getVertexList()[0];
+      for (Graph::VertexData* vertex : graph.getVertexList()) {
+        if (vertex->station_.id_ < start->station_.id_) {
+          start = vertex;
+        }
+      }
+      std::vector<bool> is_visited(graph.size(), false);
+      is_visited[start->index_] = true;
+      Graph path;
+      Graph::VertexData* path_start = path.insertVertex(start->station_);
+      Graph* largest = nullptr;
+      extendPathGraph(start, &path, path_start, start, path_start, graph.size(), &is_visited, &largest);
+      graph_cycle_weight = largest == nullptr ? -std::numeric_limits<double>::infinity() : largest->getTotalDistance();
+      delete largest;
+    };
+    std::vector<Graph::VertexData*> cycle;
+    double cycle_weight = 0;
+    auto search_with_path_state = [&]() {
+      cycle_weight = graph.findLargestHamiltonianCycle(&cycle, 1);
+    };
+
+    size_t bytes = 0;
+    double graph_seconds = timeBest(search_with_graphs);
+    size_t graph_allocations = countAllocations(search_with_graphs, &bytes);
+    double path_state_seconds = timeBest(search_with_path_state);
+    size_t path_state_allocations = countAllocations(search_with_path_state, &bytes);
+    std::cout << std::setw(20) << named_graph.first << std::setw(14) << "path graph" << std::setw(12)
+        << graph_seconds * 1e3 << std::setw(12) << 1 << std::setw(14) << graph_allocations << std::setw(16)
+        << graph_cycle_weight << std::endl;
+    std::cout << std::setw(20) << named_graph.first << std::setw(14) << "path state" << std::setw(12)
+        << path_state_seconds * 1e3 << std::setw(12) << graph_seconds / path_state_seconds << std::setw(14)
+        << path_state_allocations << std::setw(16) << cycle_weight << std::endl;
+    delete named_graph.second;
+  }
+}
+
+/**
+ * Times the long hamiltonian cycle heuristic against the exact search on neighborhoods of the full
+ * dataset, and runs it with time budgets and 1 to 16 threads on the stations of the full dataset with
+ * more than two neighbors (stations with one neighbor can't be on a cycle) and on random graphs
+ */
+void benchmarkLongHamiltonian() {
+  Graph full_data;
+  loadAllData(&full_data);
+  std::vector<Graph::VertexData*> cycle;
+  Graph::LongCycleBudget budget;
+  budget.seconds_ = 0;
+  budget.num_restarts_ = 16;
+  budget.num_threads_ = 1;
+  for (size_t num_stations : {12, 13}) {
+    Graph neighborhood;
+    makeNeighborhood(full_data, full_data.getNorthwestMost(), num_stations, &neighborhood);
+    double largest_weight = 0;
+    double long_weight = 0;
+    double exact_seconds = timeBest([&]() { largest_weight = neighborhood.findLargestHamiltonianCycle(&cycle, 1); });
+    double heuristic_seconds = timeBest([&]() { long_weight = neighborhood.findLongHamiltonianCycle(&cycle, budget); });
+    std::cout << num_stations << " stations of data: exact " << largest_weight << " in " << exact_seconds * 1e3
+        << " ms, heuristic (16 restarts) " << long_weight << " in " << heuristic_seconds * 1e3 << " ms" << std::endl;
+  }
+
+  std::vector<std::pair<std::string, Graph*>> graphs;
+  Graph* core = new Graph();
+  for (Graph::VertexData* vertex : full_data.getVertexList()) {
+    std::vector<Graph::VertexData*> neighbors;
+    for (Graph::Edge* edge : vertex->adjacent_edges_) {
+      neighbors.push_back(edge->getOtherVertex(vertex));
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    if (std::unique(neighbors.begin(), neighbors.end()) - neighbors.begin() > 2) {
+      core->insertVertex(vertex->station_);
+    }
+  }
+  for (Graph::Edge* edge : full_data.getEdgeList()) {
+    Graph::VertexData* vertex_one = core->getVertex(edge->start_vertex_->station_.id_);
+    Graph::VertexData* vertex_two = core->getVertex(edge->end_vertex_->station_.id_);
+    if (vertex_one != nullptr && vertex_two != nullptr) {
+      core->insertEdgeFromData(vertex_one, vertex_two);
+    }
+  }
+  graphs.push_back(std::make_pair("data (" + std::to_string(core->size()) + " V)", core));
+  Graph* random = new Graph();
+  makeRandomGraph(random, 1000, 8000, 227);
+  graphs.push_back(std::make_pair("random (1000 V)", random));
+
+  std::cout << std::thread::hardware_concurrency() << " cores" << std::endl;
+  std::cout << std::left << std::setw(20) << "graph" << std::setw(10) << "budget" << std::setw(10) << "threads"
+      << std::setw(12) << "restarts" << std::setw(16) << "cycle weight" << std::endl;
+  for (const std::pair<std::string, Graph*>& named_graph : graphs) {
+    for (double seconds : {0.1, 1.0}) {
+      for (size_t num_threads = 1; num_threads <= 16; num_threads *= 4) {
+        budget.seconds_ = seconds;
+        budget.num_restarts_ = 0;
+        budget.num_threads_ = num_threads;
+        size_t num_restarts = 0;
+        double cycle_weight = named_graph.second->findLongHamiltonianCycle(&cycle, budget, &num_restarts);
+        std::cout << std::setw(20) << named_graph.first << std::setw(10) << std::to_string(seconds).substr(0, 3) + " s"
+            << std::setw(10) << num_threads << std::setw(12) << num_restarts << std::setw(16) << cycle_weight << std::endl;
+      }
+    }
+    delete named_graph.second;
+  }
+}
+
+int main(int argc, char** argv) {
+  const std::map<std::string, void (*)()> kBenchmarks = {
+      {"a_star", benchmarkAStar},
+      {"bidirectional", benchmarkBidirectional},
+      {"components", benchmarkConnectedComponents},
+      {"contraction_hierarchy", benchmarkContractionHierarchy},
+      {"distance_matrix", benchmarkDistanceMatrix},
+      {"edge_dedup", benchmarkEdgeDeduplication},
+      {"graph_lifetime", benchmarkGraphLifetime},
+      {"hamiltonian", benchmarkHamiltonianSearch},
+      {"hamiltonian_state", benchmarkHamiltonianPathState},
+      {"heaps", benchmarkHeaps},
+      {"held_karp", benchmarkHeldKarp},
+      {"landmarks", benchmarkLandmarks},
+      {"long_hamiltonian", benchmarkLongHamiltonian},
+      {"loading", benchmarkLoading},
+      {"parallel_loading", benchmarkParallelLoading},
+      {"shortest_path_tree", benchmarkShortestPathTree},
+      {"snapshot", benchmarkSnapshot},
+      {"static_graph", benchmarkStaticGraph}};
+
+  std::vector<std::string> to_run;
+  for (int i = 1; i < argc; ++i) {
+    to_run.push_back(argv[i]);
+  }
+  if (to_run.empty()) {
+    for (const auto& benchmark : kBenchmarks) {
+      to_run.push_back(benchmark.first);
+    }
+  }
+
+  for (const std::string& name : to_run) {
+    auto benchmark = kBenchmarks.find(name);
+    if (benchmark == kBenchmarks.end()) {
+      std::cout << "unknown benchmark: " << name << std::endl;
+      return 1;
+    }
+    std::cout << "\n== " << name << " ==" << std::endl;
+    benchmark->second();
+  }
+  return 0;
+}
@@ -1,27 +1,109 @@
+#include "CSVScanner.h"
+#include "CSVScanner.cpp"
+#include "ContractionHierarchy.h"
+#include "ContractionHierarchy.cpp"
 #include "Graph.h"
 #include "Graph.cpp"
 #include "DFS.h"
 #include "DFS.cpp"
+#include "DisjointSet.h"
+#include "DisjointSet.cpp"
+#include "Landmarks.h"
+#include "Landmarks.cpp"
+#include "MappedFile.h"
+#include "MappedFile.cpp"
+#include "Snapshot.h"
+#include "Snapshot.cpp"
+#include "StaticGraph.h"
+#include "StaticGraph.cpp"
+#include "VertexHeap.h"
+#include "VertexHeap.cpp"
 
 #include <cmath>
 #include <iostream>
 #include <vector>
 
+/**
+ * Checks if a snapshot was built from the data files as they are now (the same files are present,
+ * with the same sizes and modification times)
+ *
+ * @param snapshot_path a string representing the path to the snapshot
+ * @param data_file_paths a vector of strings representing the paths to the data files
+ * @return true if the snapshot is valid and was built from exactly the data files that exist
+ */
+bool isSnapshotCurrent(const std::string& snapshot_path, const std::vector<std::string>& data_file_paths) {
+  Snapshot snapshot(snapshot_path);
+  return snapshot.isBuiltFrom(data_file_paths);
+}
+
 int main(int argc, char** argv) {
   // vector containing paths to the data files
   const std::vector<std::string> kDataFilePaths = {"data/April2020.csv", "data/April2021.csv", "data/August2020.csv", "data/December2020.csv",
       "data/February2020.csv", "data/February2021.csv", "data/January2020.csv", "data/January2021.csv", "data/July2020.csv", "data/June2020.csv",
       "data/March2020.csv", "data/March2021.csv", "data/May2020.csv", "data/November2020.csv", "data/October2020.csv", "data/September2020.csv"};
 
+  // snapshot of the graph built from the data files (rebuilt when a data file changes)
+  const std::string kSnapshotPath = "data/graph.snapshot";
+
+  // landmarks of the graph in the snapshot (see Landmarks)
+  const std::string kLandmarksPath = "data/graph.landmarks";
+
   Graph* graph = new Graph();
-  // read data into the graph
   std::cout << "creating graph" << std::endl;
-  for (const std::string& kFilePath : kDataFilePaths) {
-    std::cout << "adding data from " << kFilePath << std::endl;
-    graph->addDataFromFile(kFilePath);
+  // whether the snapshot on disk has the same edges as the graph
+  bool is_graph_in_snapshot = false;
+  if (isSnapshotCurrent(kSnapshotPath, kDataFilePaths) && graph->loadSnapshot(kSnapshotPath)) {
+    std::cout << "loaded graph from " << kSnapshotPath << std::endl;
+    is_graph_in_snapshot = true;
+  } else {
+    // read data into the graph
+    std::vector<Graph::LoadStats> load_stats = graph->addDataFromFiles(kDataFilePaths, 0);
+    for (const Graph::LoadStats& file_stats : load_stats) {
+      if (file_stats.is_missing_) {
+        std::cout << "missing data file: " << file_stats.file_path_ << std::endl;
+        continue;
+      }
+      if (file_stats.has_read_error_) {
+        std::cout << "error reading data file: " << file_stats.file_path_ << std::endl;
+      }
+      std::cout << "added data from " << file_stats.file_path_ << " (" << file_stats.num_rows_ << " rows, "
+          << file_stats.num_rejected_rows_ << " rejected)" << std::endl;
+    }
+    if (graph->saveSnapshot(kSnapshotPath, kDataFilePaths)) {
+      std::cout << "saved graph to " << kSnapshotPath << std::endl;
+      // use the graph loaded back from the snapshot (its verticies are in order of station id), so
+      // this run has the same vertex and edge order as later runs and the landmarks saved below
+      // match the graph they load
+      Graph* snapshot_graph = new Graph();
+      if (snapshot_graph->loadSnapshot(kSnapshotPath)) {
+        delete graph;
+        graph = snapshot_graph;
+        is_graph_in_snapshot = true;
+      } else {
+        delete snapshot_graph;
+      }
+    }
   }
   std::cout << "graph created successfully" << std::endl;
 
+  // landmark distance tables for routing, tied to the edges of the graph by the snapshot's checksum
+  // (rebuilt when the snapshot changes, and not saved or loaded if the graph couldn't be saved)
+  uint64_t graph_checksum = 0;
+  if (is_graph_in_snapshot) {
+    Snapshot snapshot(kSnapshotPath);
+    is_graph_in_snapshot = snapshot.isValid();
+    graph_checksum = snapshot.getHeader().checksum_;
+  }
+  Landmarks landmarks;
+  if (is_graph_in_snapshot && landmarks.load(kLandmarksPath, *graph, graph_checksum)) {
+    std::cout << "loaded landmarks from " << kLandmarksPath << std::endl;
+  } else {
+    landmarks = Landmarks(*graph, Landmarks::kDefaultNumLandmarks);
+    if (is_graph_in_snapshot && landmarks.save(kLandmarksPath, graph_checksum)) {
+      std::cout << "saved landmarks to " << kLandmarksPath << std::endl;
+    }
+  }
+
   std::cout << "\ngraph results" << std::endl;
   // check if the graph is connected
   std::cout << "graph is connected: " << graph->isConnected() << std::endl;
@@ -44,26 +126,18 @@ int main(int argc, char** argv) {
   Graph::VertexData* ending_vertex = graph->getSoutheastMost();
   std::cout << "southeast most station: " << ending_vertex->station_.id_ << std::endl;
 
-  // start Dijkstras from the nortwest most vertex
-  std::pair<Graph, std::map<int, Graph::VertexData*>> dijkstras_result = graph->Dijkstras(starting_vertex);
-  Graph dijkstras_dag = dijkstras_result.first;
-  std::cout << "degrees latitude across new york: " << dijkstras_dag.getTotalDistance() << std::endl;
-
-  // find shortest path accross NYC using Dijkstra's result
-  std::map<int, Graph::VertexData*> previous_verticies_map = dijkstras_result.second;
-  Graph::VertexData* previous = previous_verticies_map[ending_vertex->station_.id_];
-  std::vector<int> stations_to_travel;
-  stations_to_travel.insert(stations_to_travel.begin(), ending_vertex->station_.id_);
-  while (previous != nullptr) {
-    stations_to_travel.insert(stations_to_travel.begin(), previous->station_.id_);
-    previous = previous_verticies_map[previous->station_.id_];
-  }
- // stations_to_travel.insert(stations_to_travel.begin(), starting_vertex->station_.id_);
+  // find shortest path accross NYC (A* from the northwest most vertex to the southeast most vertex,
+  // bounding the distance left with the landmarks)
+  std::vector<Graph::VertexData*> path;
+  size_t num_settled = 0;
+  double path_distance = graph->AStar(starting_vertex, ending_vertex, &path, &num_settled, landmarks.getHeuristic());
+  std::cout << "degrees latitude across new york: " << path_distance << std::endl;
+  std::cout << "stations searched: " << num_settled << std::endl;
 
-  // print out the shortest path across NYC produced by Dijkstra's
+  // print out the shortest path across NYC
   std::cout << "shortest station path across NYC: " << std::endl;
-  for (const int kStationId : stations_to_travel) {
-    std::cout << kStationId << " ";
+  for (Graph::VertexData* vertex : path) {
+    std::cout << vertex->station_.id_ << " ";
   }
   std::cout << std::endl;
   return 0;
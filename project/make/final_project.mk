@@ -2,6 +2,7 @@
 # This is a generic Makefile designed to compile a sample directory of code.
 # This file depends on variables having been set before calling:
 #   EXE: The name of the result file
+#   BENCH: Optional name of the benchmark executable (built from benchmarks/benchmarks.cpp)
 #   OBJS: Array of objects files (.o) to be generated
 #   CLEAN_RM: Optional list of additional files to delete on `make clean`
 #
@@ -27,10 +28,10 @@ DEPFILE_FLAGS = -MMD -MP
 WARNINGS = -pedantic -Wall -Werror -Wfatal-errors -Wextra -Wno-unused-parameter -Wno-unused-variable -Wno-unused-function
 
 # Flags for compile:
-CXXFLAGS += $(CS225) -std=c++14 -stdlib=libc++ -O0 $(WARNINGS) $(DEPFILE_FLAGS) -g -c
+CXXFLAGS += $(CS225) -std=c++14 -stdlib=libc++ -pthread -O0 $(WARNINGS) $(DEPFILE_FLAGS) -g -c
 
 # Flags for linking:
-LDFLAGS += $(CS225) -std=c++14 -stdlib=libc++ -lc++abi
+LDFLAGS += $(CS225) -std=c++14 -stdlib=libc++ -pthread -lc++abi
 
 # Rule for `all` (first/default rule):
 all: $(EXE)
@@ -47,6 +48,7 @@ $(OBJS_DIR):
 	@mkdir -p $(OBJS_DIR)/project
 	@mkdir -p $(OBJS_DIR)/project/catch
 	@mkdir -p $(OBJS_DIR)/tests
+	@mkdir -p $(OBJS_DIR)/benchmarks
 
 # Rules for compiling source code.
 # - Every object file is required by $(EXE)
@@ -66,12 +68,23 @@ OBJS_TEST += $(CPP_TEST:.cpp=.o)
 $(TEST): output_msg $(patsubst %.o, $(OBJS_DIR)/%.o, $(OBJS_TEST))
 	$(LD) $(filter-out $<, $^) $(LDFLAGS) -o $@
 
+# Rules for compiling the benchmarks.
+# - Benchmarks are built with optimizations (everything else is built with -O0 for debugging)
+BENCH_CXXFLAGS = $(filter-out -O0, $(CXXFLAGS)) -O2
+
+$(OBJS_DIR)/benchmarks/benchmarks.o: benchmarks/benchmarks.cpp | $(OBJS_DIR)
+	$(CXX) $(BENCH_CXXFLAGS) $< -o $@
+
+$(BENCH): output_msg $(OBJS_DIR)/benchmarks/benchmarks.o
+	$(LD) $(filter-out $<, $^) $(LDFLAGS) -o $@
+
 # Additional dependencies for object files are included in the clang++
 # generated .d files (from $(DEPFILE_FLAGS)):
 -include $(OBJS_DIR)/*.d
 -include $(OBJS_DIR)/project/*.d
 -include $(OBJS_DIR)/project/catch/*.d
 -include $(OBJS_DIR)/tests/*.d
+-include $(OBJS_DIR)/benchmarks/*.d
 
 # Custom Clang version enforcement Makefile rule:
 ccred=$(shell echo -e "\033[0;31m")
@@ -94,7 +107,7 @@ output_msg: ; $(CLANG_VERSION_MSG)
 
 # Standard C++ Makefile rules:
 clean:
-	rm -rf $(EXE) $(TEST) $(OBJS_DIR) $(CLEAN_RM) *.o *.d
+	rm -rf $(EXE) $(TEST) $(BENCH) $(OBJS_DIR) $(CLEAN_RM) *.o *.d
 
 tidy: clean
 	rm -rf doc
@@ -1,8 +1,34 @@
 #include "../project/catch/catch.hpp"
+#include "../Arena.h"
+#include "../CSVScanner.h"
+#include "../CSVScanner.cpp"
+#include "../ContractionHierarchy.h"
+#include "../ContractionHierarchy.cpp"
 #include "../DFS.h"
 #include "../DFS.cpp"
+#include "../DisjointSet.h"
+#include "../DisjointSet.cpp"
 #include "../Graph.h"
 #include "../Graph.cpp"
+#include "../Landmarks.h"
+#include "../Landmarks.cpp"
+#include "../MappedFile.h"
+#include "../MappedFile.cpp"
+#include "../Snapshot.h"
+#include "../Snapshot.cpp"
+#include "../StaticGraph.h"
+#include "../StaticGraph.cpp"
+#include "../VertexHeap.h"
+#include "../VertexHeap.cpp"
+
+#include <algorithm>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 
 
 bool areStationsEqual(Graph::Station station_one, Graph::Station station_two) {
@@ -10,6 +36,63 @@ bool areStationsEqual(Graph::Station station_one, Graph::Station station_two) {
       && (station_one.longitude_ == station_two.longitude_);
 }
 
+// paths to every data file in the test data folder
+const std::vector<std::string> kTestDataFiles = {"tests/test_data/dijkstra1_dat.csv",
+    "tests/test_data/dijkstra2_dat.csv", "tests/test_data/hamiltonian1_dat.csv",
+    "tests/test_data/hamiltonian2_dat.csv", "tests/test_data/missing_duration_dat.csv",
+    "tests/test_data/non_hamiltonian_dat.csv",
+    "tests/test_data/repeating_edges.csv", "tests/test_data/test_dat1.csv",
+    "tests/test_data/test_dat2.csv", "tests/test_data/test_dat_ex.csv",
+    "tests/test_data/traversal1_dat.csv", "tests/test_data/traversal2_dat.csv",
+    "tests/test_data/traversal3_dat.csv", "tests/test_data/traversal4_dat.csv",
+    "tests/test_data/trip_stats_dat.csv"};
+
+/**
+ * Checks that two graphs have the same stations, the same edges (in the same order)
+ * and the same total distance
+ */
+void requireGraphsEqual(Graph& expected, Graph& actual) {
+  REQUIRE(actual.size() == expected.size());
+  for (std::pair<int, Graph::VertexData*> vertex : expected.getVertexMap()) {
+    REQUIRE(actual.getVertex(vertex.first) != nullptr);
+    REQUIRE(areStationsEqual(vertex.second->station_, actual.getVertex(vertex.first)->station_));
+  }
+  std::list<Graph::Edge*> actual_edges = actual.getEdgeList();
+  std::list<Graph::Edge*> expected_edges = expected.getEdgeList();
+  REQUIRE(actual_edges.size() == expected_edges.size());
+  auto actual_it = actual_edges.begin();
+  for (Graph::Edge* edge : expected_edges) {
+    REQUIRE((**actual_it == *edge));
+    ++actual_it;
+  }
+  REQUIRE(actual.getTotalDistance() == expected.getTotalDistance());
+}
+
+/**
+ * Checks that two sets of edge statistics count the same trips
+ */
+void requireEdgeStatsEqual(const Graph::EdgeStats& expected, const Graph::EdgeStats& actual) {
+  REQUIRE(actual.num_forward_trips_ == expected.num_forward_trips_);
+  REQUIRE(actual.num_backward_trips_ == expected.num_backward_trips_);
+  REQUIRE(actual.total_duration_ == expected.total_duration_);
+  REQUIRE(actual.min_duration_ == expected.min_duration_);
+  REQUIRE(actual.max_duration_ == expected.max_duration_);
+  REQUIRE(actual.num_subscriber_trips_ == expected.num_subscriber_trips_);
+  REQUIRE(actual.num_customer_trips_ == expected.num_customer_trips_);
+}
+
+/**
+ * Checks that every edge of two graphs (with the same edges) has the same statistics
+ */
+void requireAllEdgeStatsEqual(Graph& expected, Graph& actual) {
+  for (Graph::Edge* edge : expected.getEdgeList()) {
+    Graph::Edge* actual_edge = actual.getEdge(actual.getVertex(edge->start_vertex_->station_.id_),
+        actual.getVertex(edge->end_vertex_->station_.id_));
+    REQUIRE(actual_edge != nullptr);
+    requireEdgeStatsEqual(edge->stats_, actual_edge->stats_);
+  }
+}
+
 /**
  * Test Edge Equality Operator
  */
@@ -326,6 +409,100 @@ TEST_CASE("Self Loops", "[valgrind][graphImplementation][addEdge]") {
   REQUIRE(vertex_a->adjacent_edges_.empty());
 }
 
+TEST_CASE("Get Edge", "[graphImplementation][edgeIndex]") {
+  Graph test_graph;
+  test_graph.addDataFromFile("tests/test_data/traversal2_dat.csv");
+  for (Graph::Edge* edge : test_graph.getEdgeList()) {
+    REQUIRE(test_graph.getEdge(edge->start_vertex_, edge->end_vertex_) == edge);
+    REQUIRE(test_graph.getEdge(edge->end_vertex_, edge->start_vertex_) == edge);
+  }
+  // stations 0 and 2 are not adjacent
+  REQUIRE(test_graph.getEdge(test_graph.getVertex(0), test_graph.getVertex(2)) == nullptr);
+
+  // removing a vertex removes its edges from the index
+  Graph::VertexData* vertex_1 = test_graph.getVertex(1);
+  Graph::VertexData* vertex_4 = test_graph.getVertex(4);
+  REQUIRE(test_graph.getEdge(vertex_1, vertex_4) != nullptr);
+  test_graph.removeVertex(vertex_4);
+  REQUIRE(test_graph.getEdge(vertex_1, test_graph.getVertex(2)) != nullptr);
+  for (Graph::Edge* edge : vertex_1->adjacent_edges_) {
+    REQUIRE(test_graph.getEdge(edge->start_vertex_, edge->end_vertex_) == edge);
+  }
+}
+
+TEST_CASE("Assignment Operator Replaces Graph", "[valgrind][big3][edgeIndex]") {
+  Graph test_graph;
+  test_graph.addDataFromFile("tests/test_data/traversal2_dat.csv");
+  Graph other_graph;
+  other_graph.addDataFromFile("tests/test_data/test_dat1.csv");
+
+  test_graph = other_graph;
+  requireGraphsEqual(other_graph, test_graph);
+  for (Graph::Edge* edge : test_graph.getEdgeList()) {
+    REQUIRE(test_graph.getEdge(edge->start_vertex_, edge->end_vertex_) == edge);
+  }
+}
+
+/**
+ * Test Arena Allocation
+ */
+TEST_CASE("Arena Reuses Destroyed Slots", "[valgrind][arena]") {
+  Arena<Graph::Station> arena;
+  std::vector<Graph::Station*> stations;
+  for (int i = 0; i < 100; ++i) {
+    stations.push_back(arena.create(i, i / 2.0, -i / 2.0));
+  }
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(areStationsEqual(*stations[i], Graph::Station(i, i / 2.0, -i / 2.0)));
+  }
+  // 64 stations fit in the first chunk, and the second chunk is twice as large
+  REQUIRE(arena.getNumChunks() == 2);
+
+  Graph::Station* destroyed = stations[10];
+  arena.destroy(destroyed);
+  REQUIRE(arena.create(200, 0, 0) == destroyed);
+  REQUIRE(destroyed->id_ == 200);
+
+  arena.clear();
+  REQUIRE(arena.getNumChunks() == 0);
+  arena.reserve(1000);
+  for (int i = 0; i < 1000; ++i) {
+    arena.create(i, 0, 0);
+  }
+  REQUIRE(arena.getNumChunks() == 1);
+}
+
+TEST_CASE("Arena Destroys Objects That Own Memory", "[valgrind][arena]") {
+  Arena<std::vector<int>> arena;
+  std::vector<int>* kept = arena.create(100, 1);
+  std::vector<int>* destroyed = arena.create(100, 2);
+  arena.destroy(destroyed);
+  std::vector<int>* reused = arena.create(3, 3);
+  REQUIRE(reused == destroyed);
+  REQUIRE(reused->size() == 3);
+  REQUIRE(kept->size() == 100);
+  arena.destroy(kept);
+  arena.destroy(reused);
+}
+
+TEST_CASE("Graph Built From Arenas Copies And Removes Cleanly", "[valgrind][arena][big3]") {
+  Graph* test_graph = new Graph();
+  test_graph->addDataFromFile("tests/test_data/hamiltonian2_dat.csv");
+  Graph copied_graph(*test_graph);
+  requireGraphsEqual(*test_graph, copied_graph);
+
+  // removed verticies and edges are returned to the arenas and reused
+  size_t num_verticies = copied_graph.size();
+  copied_graph.removeVertex(copied_graph.getVertex(0));
+  copied_graph.removeVertex(copied_graph.getVertex(1));
+  copied_graph = *test_graph;
+  requireGraphsEqual(*test_graph, copied_graph);
+  REQUIRE(copied_graph.size() == num_verticies);
+
+  REQUIRE(test_graph->getLargestHamiltonianCycle() != nullptr);
+  delete test_graph;
+}
+
 /**
  * Test Reading Data into graph from file
  */
@@ -458,6 +635,376 @@ TEST_CASE("Repeated Edges", "[valgrind][dataFromFile]") {
    REQUIRE((*(second_vertex->adjacent_edges_.front()) == expected_edge_a));
 }
 
+/**
+ * Test CSV Scanner
+ */
+
+/**
+ * Reference loader that reads data the way addDataFromFile did before the CSV scanner
+ * (regex tokenizer and stringstreams), used to check both produce identical graphs
+ */
+void addDataWithRegex(Graph* graph, std::string file_path) {
+  std::string data;
+  std::ifstream data_file(file_path);
+  const std::regex separate_by_commas("[^,]*");
+  std::getline(data_file, data);
+  while (std::getline(data_file, data)) {
+    data.erase(std::remove(data.begin(), data.end(), ' '), data.end());
+    std::sregex_iterator it = std::sregex_iterator(data.begin(), data.end(), separate_by_commas);
+    if (std::distance(it, std::sregex_iterator()) != 30) {
+      continue;
+    }
+    std::vector<std::string> data_points;
+    for (; it != std::sregex_iterator(); ++it) {
+      data_points.push_back((*it).str());
+    }
+    Graph::Station start;
+    Graph::Station end;
+    std::stringstream(data_points[6]) >> start.id_;
+    std::stringstream(data_points[10]) >> start.latitude_;
+    std::stringstream(data_points[12]) >> start.longitude_;
+    std::stringstream(data_points[14]) >> end.id_;
+    std::stringstream(data_points[18]) >> end.latitude_;
+    std::stringstream(data_points[20]) >> end.longitude_;
+    graph->insertVertex(start);
+    graph->insertVertex(end);
+    graph->insertEdgeFromData(graph->getVertex(start.id_), graph->getVertex(end.id_));
+  }
+}
+
+TEST_CASE("Split Row", "[CSVScanner]") {
+  std::string row = "10, \"2020-04-01 01:06:20\", 3,\"Name, With Comma\",\" 40.5 \",-74.25,7,b,1,2,3,4,5,6,7";
+  CSVScanner::Field fields[CSVScanner::kNumColumns];
+  REQUIRE(CSVScanner::splitRow(row.data(), row.data() + row.size(), fields) == 15);
+  REQUIRE(std::string(fields[1].begin_, fields[1].end_) == "2020-04-01 01:06:20");
+  REQUIRE(std::string(fields[3].begin_, fields[3].end_) == "Name, With Comma");
+
+  double latitude;
+  REQUIRE(CSVScanner::parseDouble(fields[4], &latitude));
+  REQUIRE(latitude == 40.5);
+  int station_id;
+  REQUIRE(CSVScanner::parseInt(fields[2], &station_id));
+  REQUIRE(station_id == 3);
+  REQUIRE_FALSE(CSVScanner::parseInt(fields[7], &station_id));
+}
+
+TEST_CASE("Rows Without 15 Data Points Are Skipped", "[CSVScanner]") {
+  Graph::Trip trip;
+  std::string too_few = "1,2,3,4,5,6,7,8,9,10,11,12,13,14";
+  std::string too_many = "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16";
+  std::string empty_data_point = "1,2,3,4,5,6,7,8,9,10,11,,13,14,15";
+  std::string valid = "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15\r";
+  REQUIRE_FALSE(CSVScanner::parseTrip(too_few.data(), too_few.data() + too_few.size(), &trip));
+  REQUIRE_FALSE(CSVScanner::parseTrip(too_many.data(), too_many.data() + too_many.size(), &trip));
+  REQUIRE_FALSE(CSVScanner::parseTrip(empty_data_point.data(),
+      empty_data_point.data() + empty_data_point.size(), &trip));
+  REQUIRE(CSVScanner::parseTrip(valid.data(), valid.data() + valid.size(), &trip));
+  REQUIRE(areStationsEqual(trip.start_station_, Graph::Station(4, 6, 7)));
+  REQUIRE(areStationsEqual(trip.end_station_, Graph::Station(8, 10, 11)));
+}
+
+TEST_CASE("Parse Doubles Like A Stringstream", "[CSVScanner]") {
+  std::vector<std::string> values = {"40.727595966", "-74.0496379137039", "0", "-0.5", "112",
+      "40.71653978099194", "1e3", "12345678901234567890.5", ".25", "3."};
+  for (const std::string& value : values) {
+    CSVScanner::Field field;
+    field.begin_ = value.data();
+    field.end_ = value.data() + value.size();
+    double scanned;
+    double streamed;
+    std::stringstream(value) >> streamed;
+    REQUIRE(CSVScanner::parseDouble(field, &scanned));
+    REQUIRE(scanned == streamed);
+  }
+
+  std::vector<std::string> invalid_values = {"nan", "-nan", "NAN", "inf", "-Infinity", "1e999", "0x1p3", "0X10",
+      "abc", ""};
+  for (const std::string& value : invalid_values) {
+    CSVScanner::Field field;
+    field.begin_ = value.data();
+    field.end_ = value.data() + value.size();
+    double scanned;
+    REQUIRE_FALSE(CSVScanner::parseDouble(field, &scanned));
+  }
+}
+
+TEST_CASE("Rows With Values That Are Not Finite Are Skipped", "[CSVScanner][dataFromFile]") {
+  Graph::Trip trip;
+  std::string nan_latitude = "1,2,3,4,5,nan,7,8,9,10,11,12,13,14,15";
+  std::string infinite_longitude = "1,2,3,4,5,6,7,8,9,10,inf,12,13,14,15";
+  std::string nan_duration = "nan,2,3,4,5,6,7,8,9,10,11,12,13,14,15";
+  REQUIRE_FALSE(CSVScanner::parseTrip(nan_latitude.data(), nan_latitude.data() + nan_latitude.size(), &trip));
+  REQUIRE_FALSE(CSVScanner::parseTrip(infinite_longitude.data(),
+      infinite_longitude.data() + infinite_longitude.size(), &trip));
+  // a duration that can't be read keeps the row, but leaves it out of the edge statistics
+  REQUIRE(CSVScanner::parseTrip(nan_duration.data(), nan_duration.data() + nan_duration.size(), &trip));
+  REQUIRE_FALSE(trip.has_duration_);
+
+  Graph with_data;
+  Graph::LoadStats stats = with_data.addDataFromMappedFile("tests/test_data/not_finite_dat.csv");
+  REQUIRE(stats.num_rows_ == 3);
+  REQUIRE(stats.num_rejected_rows_ == 2);
+  REQUIRE(with_data.size() == 2);
+  REQUIRE(with_data.getTotalDistance() == 1);
+}
+
+TEST_CASE("CSV Scanner Matches Regex Tokenizer", "[CSVScanner][dataFromFile]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph scanned;
+    scanned.addDataFromFile(file);
+    Graph expected;
+    addDataWithRegex(&expected, file);
+
+    requireGraphsEqual(expected, scanned);
+  }
+}
+
+/**
+ * Test Edge Statistics
+ */
+TEST_CASE("Edge Statistics From Data", "[dataFromFile][edgeStats]") {
+  Graph with_data;
+  with_data.addDataFromFile("tests/test_data/trip_stats_dat.csv");
+  Graph::VertexData* vertex_0 = with_data.getVertex(0);
+  Graph::VertexData* vertex_1 = with_data.getVertex(1);
+
+  // one trip each way between stations 0 and 1
+  Graph::Edge* edge = with_data.getEdge(vertex_0, vertex_1);
+  REQUIRE(edge->stats_.getNumTrips() == 2);
+  REQUIRE(edge->stats_.num_forward_trips_ == 1);
+  REQUIRE(edge->stats_.num_backward_trips_ == 1);
+  REQUIRE(edge->stats_.total_duration_ == 220);
+  REQUIRE(edge->stats_.min_duration_ == 100);
+  REQUIRE(edge->stats_.max_duration_ == 120);
+  REQUIRE(edge->stats_.getMeanDuration() == 110);
+  REQUIRE(edge->stats_.num_subscriber_trips_ == 1);
+  REQUIRE(edge->stats_.num_customer_trips_ == 1);
+
+  // three trips from station 0 to station 3
+  Graph::Edge* popular_edge = with_data.getEdge(vertex_0, with_data.getVertex(3));
+  bool is_forward = (popular_edge->start_vertex_ == vertex_0);
+  REQUIRE(popular_edge->stats_.num_forward_trips_ == (is_forward ? 3u : 0u));
+  REQUIRE(popular_edge->stats_.num_backward_trips_ == (is_forward ? 0u : 3u));
+  REQUIRE(popular_edge->stats_.num_customer_trips_ == 3);
+  REQUIRE(popular_edge->stats_.getMeanDuration() == 500);
+}
+
+TEST_CASE("Trips Without A Duration Keep Their Edge", "[dataFromFile][edgeStats]") {
+  Graph with_data;
+  Graph::LoadStats stats = with_data.addDataFromFile("tests/test_data/missing_duration_dat.csv");
+  REQUIRE(stats.num_rows_ == 4);
+  REQUIRE(stats.num_rejected_rows_ == 0);
+  REQUIRE(with_data.size() == 3);
+  Graph::VertexData* vertex_0 = with_data.getVertex(0);
+  Graph::VertexData* vertex_1 = with_data.getVertex(1);
+  Graph::VertexData* vertex_2 = with_data.getVertex(2);
+
+  // the only trip from station 1 to station 2 has no duration, so the edge has no statistics
+  Graph::Edge* untimed_edge = with_data.getEdge(vertex_1, vertex_2);
+  REQUIRE(untimed_edge != nullptr);
+  REQUIRE(untimed_edge->stats_.getNumTrips() == 0);
+
+  // the trip without a duration is left out of the statistics of the edge it shares
+  Graph::Edge* edge = with_data.getEdge(vertex_0, vertex_1);
+  REQUIRE(edge->stats_.getNumTrips() == 1);
+  REQUIRE(edge->stats_.getMeanDuration() == 100);
+  REQUIRE(edge->stats_.num_customer_trips_ == 0);
+  REQUIRE(with_data.getEdge(vertex_2, vertex_0)->stats_.getMeanDuration() == 300);
+
+  // the threaded loader keeps the same edges and statistics
+  Graph loaded_in_parallel;
+  loaded_in_parallel.addDataFromFile("tests/test_data/missing_duration_dat.csv", 2);
+  requireGraphsEqual(with_data, loaded_in_parallel);
+  requireAllEdgeStatsEqual(with_data, loaded_in_parallel);
+}
+
+TEST_CASE("Edge Statistics Are Copied", "[big3][edgeStats]") {
+  Graph with_data;
+  with_data.addDataFromFile("tests/test_data/trip_stats_dat.csv");
+  Graph copied(with_data);
+  requireAllEdgeStatsEqual(with_data, copied);
+}
+
+TEST_CASE("Dijkstra's With Different Weights", "[Dijkstras][edgeStats]") {
+  Graph with_data;
+  with_data.addDataFromFile("tests/test_data/trip_stats_dat.csv");
+  Graph::VertexData* start = with_data.getVertex(0);
+
+  // the diagonal from station 0 to station 2 is the shortest distance
+  Graph::VertexData* station_2 = with_data.getVertex(2);
+  Graph::ShortestPathTree by_distance = with_data.Dijkstras(start);
+  REQUIRE(by_distance.getParent(station_2)->station_.id_ == 0);
+  Graph::ShortestPathTree by_geometric_distance = with_data.Dijkstras(start, Graph::GeometricDistance());
+  REQUIRE(by_geometric_distance.getParent(station_2)->station_.id_ == 0);
+
+  // the trips through station 1 are the quickest
+  Graph::ShortestPathTree by_duration = with_data.Dijkstras(start, Graph::MeanDuration());
+  REQUIRE(by_duration.getParent(station_2)->station_.id_ == 1);
+
+  // the trips through station 3 are the most popular
+  Graph::ShortestPathTree by_popularity = with_data.Dijkstras(start, Graph::InversePopularity());
+  REQUIRE(by_popularity.getParent(station_2)->station_.id_ == 3);
+  REQUIRE(by_popularity.getParent(with_data.getVertex(3))->station_.id_ == 0);
+}
+
+/**
+ * Test Memory Mapped Loading
+ */
+TEST_CASE("Mapped File Matches Buffered File", "[dataFromFile][mappedFile]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph buffered;
+    Graph::LoadStats buffered_stats = buffered.addDataFromFile(file);
+    Graph mapped;
+    Graph::LoadStats mapped_stats = mapped.addDataFromMappedFile(file);
+
+    requireGraphsEqual(buffered, mapped);
+    requireAllEdgeStatsEqual(buffered, mapped);
+    REQUIRE(mapped_stats.num_rows_ == buffered_stats.num_rows_);
+    REQUIRE(mapped_stats.num_rejected_rows_ == buffered_stats.num_rejected_rows_);
+    REQUIRE(mapped_stats.num_bytes_ > 0);
+  }
+}
+
+TEST_CASE("Mapped File Counts Rows", "[dataFromFile][mappedFile]") {
+  Graph with_data;
+  Graph::LoadStats stats = with_data.addDataFromMappedFile("tests/test_data/test_dat1.csv");
+  REQUIRE(stats.file_path_ == "tests/test_data/test_dat1.csv");
+  REQUIRE(stats.num_rows_ == 2);
+  REQUIRE(stats.num_rejected_rows_ == 0);
+  REQUIRE(with_data.size() == 3);
+  REQUIRE(with_data.getEdgeList().size() == 2);
+}
+
+TEST_CASE("Missing File Adds No Data", "[dataFromFile][mappedFile]") {
+  Graph with_data;
+  Graph::LoadStats stats = with_data.addDataFromMappedFile("tests/test_data/missing.csv");
+  REQUIRE(stats.is_missing_);
+  REQUIRE(with_data.addDataFromFile("tests/test_data/missing.csv").is_missing_);
+  REQUIRE(stats.num_rows_ == 0);
+  REQUIRE(stats.num_bytes_ == 0);
+  REQUIRE(with_data.size() == 0);
+}
+
+TEST_CASE("Read Error Stops Loading The File", "[dataFromFile][mappedFile]") {
+  // a directory can be opened but not read
+  Graph with_data;
+  Graph::LoadStats stats = with_data.addDataFromMappedFile("tests/test_data");
+  REQUIRE_FALSE(stats.is_missing_);
+  REQUIRE(stats.has_read_error_);
+  REQUIRE(stats.num_rows_ == 0);
+  REQUIRE(with_data.size() == 0);
+  REQUIRE(with_data.addDataFromFile("tests/test_data").has_read_error_);
+  REQUIRE(with_data.size() == 0);
+  Graph streamed;
+  REQUIRE_FALSE(streamed.addDataFromFile("tests/test_data/test_dat2.csv").has_read_error_);
+
+  std::vector<Graph::LoadStats> file_stats = with_data.addDataFromFiles({"tests/test_data",
+      "tests/test_data/test_dat1.csv"}, 2);
+  REQUIRE(file_stats[0].has_read_error_);
+  REQUIRE(file_stats[0].num_rows_ == 0);
+  REQUIRE_FALSE(file_stats[1].has_read_error_);
+  Graph expected;
+  expected.addDataFromFile("tests/test_data/test_dat1.csv");
+  requireGraphsEqual(expected, with_data);
+}
+
+TEST_CASE("Pipe Falls Back To Buffered Reads", "[dataFromFile][mappedFile]") {
+  const std::string kPipePath = "tests/test_data/traversal2_pipe";
+  unlink(kPipePath.c_str());
+  REQUIRE(mkfifo(kPipePath.c_str(), 0600) == 0);
+
+  // write the data file into the pipe from a child process
+  pid_t writer = fork();
+  if (writer == 0) {
+    std::ifstream data_file("tests/test_data/traversal2_dat.csv");
+    std::ofstream pipe(kPipePath);
+    pipe << data_file.rdbuf();
+    pipe.close();
+    _exit(0);
+  }
+  Graph piped;
+  Graph::LoadStats stats = piped.addDataFromMappedFile(kPipePath);
+  waitpid(writer, nullptr, 0);
+  unlink(kPipePath.c_str());
+
+  Graph expected;
+  expected.addDataFromFile("tests/test_data/traversal2_dat.csv");
+  requireGraphsEqual(expected, piped);
+  REQUIRE(stats.num_rows_ > 0);
+}
+
+/**
+ * Test Parallel Loading
+ */
+TEST_CASE("Parallel Parse Matches Serial Parse", "[dataFromFile][parallel]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph serial;
+    Graph::LoadStats serial_stats = serial.addDataFromFile(file);
+    for (size_t num_threads = 2; num_threads <= 8; num_threads *= 2) {
+      Graph parallel;
+      Graph::LoadStats parallel_stats = parallel.addDataFromFile(file, num_threads);
+      requireGraphsEqual(serial, parallel);
+      requireAllEdgeStatsEqual(serial, parallel);
+      REQUIRE(parallel_stats.num_rows_ == serial_stats.num_rows_);
+      REQUIRE(parallel_stats.num_rejected_rows_ == serial_stats.num_rejected_rows_);
+    }
+  }
+}
+
+TEST_CASE("Parallel Parse With More Threads Than Bytes", "[dataFromFile][parallel]") {
+  // most of the chunks are empty, and their bounds are clamped to the end of the data
+  Graph serial;
+  serial.addDataFromFile("tests/test_data/test_dat2.csv");
+  Graph parallel;
+  Graph::LoadStats parallel_stats = parallel.addDataFromFile("tests/test_data/test_dat2.csv", 512);
+  requireGraphsEqual(serial, parallel);
+  REQUIRE(parallel_stats.num_rejected_rows_ == 0);
+}
+
+TEST_CASE("Parallel Parse Of Multiple Files", "[dataFromFile][parallel]") {
+  Graph serial;
+  serial.addDataFromFile("tests/test_data/test_dat1.csv");
+  serial.addDataFromFile("tests/test_data/test_dat2.csv");
+  Graph parallel;
+  parallel.addDataFromFile("tests/test_data/test_dat1.csv", 3);
+  parallel.addDataFromFile("tests/test_data/test_dat2.csv", 3);
+  requireGraphsEqual(serial, parallel);
+}
+
+TEST_CASE("Concurrent Files Match Sequential Files", "[dataFromFile][parallel]") {
+  Graph sequential;
+  std::vector<Graph::LoadStats> sequential_stats;
+  for (const std::string& file : kTestDataFiles) {
+    sequential_stats.push_back(sequential.addDataFromFile(file));
+  }
+  for (size_t num_threads = 1; num_threads <= 4; ++num_threads) {
+    Graph concurrent;
+    std::vector<Graph::LoadStats> concurrent_stats = concurrent.addDataFromFiles(kTestDataFiles, num_threads);
+    requireGraphsEqual(sequential, concurrent);
+    requireAllEdgeStatsEqual(sequential, concurrent);
+    REQUIRE(concurrent_stats.size() == kTestDataFiles.size());
+    for (size_t i = 0; i < kTestDataFiles.size(); ++i) {
+      REQUIRE(concurrent_stats[i].file_path_ == kTestDataFiles[i]);
+      REQUIRE(concurrent_stats[i].num_rows_ == sequential_stats[i].num_rows_);
+      REQUIRE(concurrent_stats[i].num_rejected_rows_ == sequential_stats[i].num_rejected_rows_);
+      REQUIRE_FALSE(concurrent_stats[i].is_missing_);
+    }
+  }
+}
+
+TEST_CASE("Concurrent Files Reports Missing Files", "[dataFromFile][parallel]") {
+  Graph with_data;
+  std::vector<std::string> files = {"tests/test_data/test_dat1.csv", "tests/test_data/missing.csv",
+      "tests/test_data/test_dat2.csv"};
+  std::vector<Graph::LoadStats> stats = with_data.addDataFromFiles(files, 2);
+  REQUIRE_FALSE(stats[0].is_missing_);
+  REQUIRE(stats[1].is_missing_);
+  REQUIRE(stats[1].num_rows_ == 0);
+  REQUIRE_FALSE(stats[2].is_missing_);
+  REQUIRE(with_data.size() == 4);
+  REQUIRE(with_data.getEdgeList().size() == 3);
+}
+
 /**
  * Test DFS Traversal
  */
@@ -520,6 +1067,33 @@ TEST_CASE("Test DFS With Multiple Connnnected Components", "[DFS]") {
   delete test_graph;
 }
 
+TEST_CASE("DFS Labels Discovery And Back Edges", "[valgrind][DFS]") {
+  Graph test_graph;
+  test_graph.addDataFromFile("tests/test_data/traversal4_dat.csv");
+  DFS test_traversal = DFS(&test_graph, test_graph.getVertex(0));
+  for (Graph::Edge* edge : test_graph.getEdgeList()) {
+    REQUIRE(test_traversal.getEdgeLabel(edge) == Graph::kUnexplored);
+  }
+  for (auto it = test_traversal.begin(); it != test_traversal.end(); ++it) {
+    REQUIRE(test_traversal.getVertexLabel(*it) == Graph::kVisited);
+  }
+
+  // the discovery edges form a spanning tree of each connected component
+  size_t num_discovery_edges = 0;
+  for (Graph::Edge* edge : test_graph.getEdgeList()) {
+    Graph::Label label = test_traversal.getEdgeLabel(edge);
+    REQUIRE((label == Graph::kDiscovery || label == Graph::kBack));
+    if (label == Graph::kDiscovery) {
+      ++num_discovery_edges;
+    }
+  }
+  REQUIRE(num_discovery_edges == test_graph.size() - test_traversal.getNumConnectedComponents());
+
+  // a second traversal starts with every label unexplored
+  DFS second_traversal = DFS(&test_graph, test_graph.getVertex(0));
+  REQUIRE(second_traversal.getVertexLabel(test_graph.getVertex(5)) == Graph::kUnexplored);
+}
+
 /**
  * Test for connectivity and euler path/circuit
  */
@@ -683,6 +1257,119 @@ TEST_CASE("Multiple Eulerian Cycles", "[valgrind][checkConnected][checkEulerian]
   REQUIRE(eulerian_cycle.isEulerian() == 2);
 }
 
+TEST_CASE("Disjoint Set Joins Sets", "[valgrind][components]") {
+  DisjointSet sets(6);
+  REQUIRE(sets.getNumSets() == 6);
+  REQUIRE(sets.unite(0, 1));
+  REQUIRE(sets.unite(2, 3));
+  REQUIRE(sets.unite(1, 3));
+  REQUIRE_FALSE(sets.unite(0, 2));
+  REQUIRE(sets.getNumSets() == 3);
+  REQUIRE(sets.find(0) == sets.find(3));
+  REQUIRE(sets.getSet(2) == sets.find(1));
+  REQUIRE(sets.getSet(4) != sets.getSet(0));
+  REQUIRE(sets.getSet(4) != sets.getSet(5));
+
+  REQUIRE(sets.addElement() == 6);
+  REQUIRE(sets.getNumSets() == 4);
+  REQUIRE(sets.unite(6, 4));
+  sets.compressPaths();
+  for (uint32_t element = 0; element < sets.size(); ++element) {
+    // every element points straight at its root
+    uint32_t root = sets.getSet(element);
+    REQUIRE(sets.getSet(root) == root);
+  }
+  REQUIRE(sets.getSet(6) == sets.getSet(4));
+
+  sets.reset(2);
+  REQUIRE(sets.size() == 2);
+  REQUIRE(sets.getNumSets() == 2);
+}
+
+/**
+ * Checks that the connected components of a graph match the ones found by walking its edges
+ */
+void requireComponentsMatchTraversal(Graph& graph) {
+  std::vector<int> labels(graph.size(), -1);
+  int num_components = 0;
+  for (Graph::VertexData* vertex : graph.getVertexList()) {
+    if (labels[vertex->index_] != -1) {
+      continue;
+    }
+    std::vector<Graph::VertexData*> stack = {vertex};
+    labels[vertex->index_] = num_components;
+    while (!stack.empty()) {
+      Graph::VertexData* current = stack.back();
+      stack.pop_back();
+      for (Graph::Edge* edge : current->adjacent_edges_) {
+        Graph::VertexData* other_vertex = edge->getOtherVertex(current);
+        if (labels[other_vertex->index_] == -1) {
+          labels[other_vertex->index_] = num_components;
+          stack.push_back(other_vertex);
+        }
+      }
+    }
+    num_components += 1;
+  }
+  REQUIRE(graph.getNumConnectedComponents() == static_cast<size_t>(num_components));
+  REQUIRE(graph.isConnected() == (num_components == 1));
+  // each traversal label has one component id, and no two labels share one
+  std::map<int, uint32_t> component_of_label;
+  std::map<uint32_t, int> label_of_component;
+  for (Graph::VertexData* vertex : graph.getVertexList()) {
+    uint32_t component = graph.getComponent(vertex);
+    REQUIRE(component_of_label.emplace(labels[vertex->index_], component).first->second == component);
+    REQUIRE(label_of_component.emplace(component, labels[vertex->index_]).first->second == labels[vertex->index_]);
+  }
+}
+
+TEST_CASE("Connected Components Match A Traversal", "[valgrind][checkConnected][components]") {
+  SECTION("Data files") {
+    for (const std::string& file_path : kTestDataFiles) {
+      Graph graph;
+      graph.addDataFromFile(file_path);
+      requireComponentsMatchTraversal(graph);
+      Graph copy(graph);
+      requireComponentsMatchTraversal(copy);
+    }
+  }
+
+  SECTION("Edges inserted one at a time") {
+    std::mt19937 generator(25);
+    Graph graph;
+    for (int id = 0; id < 60; ++id) {
+      graph.insertVertex(Graph::Station(id, 0, 0));
+    }
+    REQUIRE(graph.getNumConnectedComponents() == 60);
+    for (int i = 0; i < 50; ++i) {
+      graph.insertEdgeFromData(graph.getVertex(generator() % 60), graph.getVertex(generator() % 60));
+      requireComponentsMatchTraversal(graph);
+    }
+  }
+
+  SECTION("Removing a vertex splits its component") {
+    Graph path;
+    for (int id = 0; id < 5; ++id) {
+      path.insertVertex(Graph::Station(id, 0, id));
+      if (id > 0) {
+        path.insertEdge(path.getVertex(id - 1), path.getVertex(id));
+      }
+    }
+    REQUIRE(path.isConnected());
+    path.removeVertex(path.getVertex(2));
+    REQUIRE(path.getNumConnectedComponents() == 2);
+    REQUIRE(path.getComponent(path.getVertex(0)) == path.getComponent(path.getVertex(1)));
+    REQUIRE(path.getComponent(path.getVertex(1)) != path.getComponent(path.getVertex(3)));
+    requireComponentsMatchTraversal(path);
+  }
+
+  SECTION("Empty graph") {
+    Graph empty;
+    REQUIRE(empty.getNumConnectedComponents() == 0);
+    REQUIRE_FALSE(empty.isConnected());
+  }
+}
+
 /**
  * Test Hamiltonian Cycle
  */
@@ -714,6 +1401,285 @@ TEST_CASE("Graph Without Hamiltonian Cycle", "[valgrind][HamiltonianCycle]") {
   delete test_graph; 
 }
 
+/**
+ * Checks that a cycle visits every vertex of a graph once along edges of the graph, and that its
+ * edges add up to the given weight
+ */
+void requireHamiltonianCycle(Graph& graph, const std::vector<Graph::VertexData*>& cycle, double cycle_weight) {
+  REQUIRE(cycle.size() == graph.size());
+  std::vector<bool> is_on_cycle(graph.size(), false);
+  double weight = 0;
+  for (size_t i = 0; i < cycle.size(); ++i) {
+    REQUIRE_FALSE(is_on_cycle[cycle[i]->index_]);
+    is_on_cycle[cycle[i]->index_] = true;
+    Graph::Edge* edge = graph.getEdge(cycle[i], cycle[(i + 1) % cycle.size()]);
+    REQUIRE(edge != nullptr);
+    weight += edge->getEdgeDistance();
+  }
+  REQUIRE(weight == Approx(cycle_weight));
+}
+
+TEST_CASE("Parallel Hamiltonian Search Finds The Same Cycle", "[HamiltonianCycle]") {
+  const std::vector<std::pair<std::string, std::vector<int>>> expected_cycles = {
+      {"tests/test_data/hamiltonian1_dat.csv", {0, 3, 4, 2, 1}},
+      {"tests/test_data/hamiltonian2_dat.csv", {0, 1, 2, 3, 4, 5, 6}},
+      {"tests/test_data/non_hamiltonian_dat.csv", {}}};
+  std::vector<Graph::VertexData*> cycle;
+  for (const std::pair<std::string, std::vector<int>>& expected : expected_cycles) {
+    Graph serial_graph;
+    serial_graph.addDataFromFile(expected.first);
+    Graph* serial_hamiltonian = serial_graph.getLargestHamiltonianCycle(1);
+    for (size_t num_threads : {1, 2, 4}) {
+      Graph graph;
+      graph.addDataFromFile(expected.first);
+      graph.findLargestHamiltonianCycle(&cycle, num_threads);
+      std::vector<int> cycle_ids;
+      for (Graph::VertexData* vertex : cycle) {
+        cycle_ids.push_back(vertex->station_.id_);
+      }
+      REQUIRE(cycle_ids == expected.second);
+      Graph* largest_hamiltonian = graph.getLargestHamiltonianCycle(num_threads);
+      if (serial_hamiltonian == nullptr) {
+        REQUIRE(largest_hamiltonian == nullptr);
+        continue;
+      }
+      requireGraphsEqual(*serial_hamiltonian, *largest_hamiltonian);
+    }
+  }
+
+  // every number of threads keeps the same cycle when there are many to choose from
+  std::mt19937 generator(121);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  for (int num_verticies = 4; num_verticies <= 12; ++num_verticies) {
+    Graph graph;
+    for (int id = 0; id < num_verticies; ++id) {
+      graph.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+    }
+    for (int i = 0; i < num_verticies * 3; ++i) {
+      graph.insertEdgeFromData(graph.getVertex(generator() % num_verticies), graph.getVertex(generator() % num_verticies));
+    }
+    std::vector<Graph::VertexData*> serial_cycle;
+    double serial_weight = graph.findLargestHamiltonianCycle(&serial_cycle, 1);
+    if (!serial_cycle.empty()) {
+      requireHamiltonianCycle(graph, serial_cycle, serial_weight);
+    }
+    // Held-Karp finds the largest cycle another way, as a reference for the search
+    std::vector<Graph::VertexData*> held_karp_cycle;
+    double held_karp_weight = graph.getLargestHamiltonianCycleHeldKarp(&held_karp_cycle, 1);
+    if (serial_cycle.empty()) {
+      REQUIRE(held_karp_cycle.empty());
+    } else {
+      REQUIRE(serial_weight == Approx(held_karp_weight));
+    }
+    for (size_t num_threads : {2, 3, 8}) {
+      REQUIRE(graph.findLargestHamiltonianCycle(&cycle, num_threads) == serial_weight);
+      REQUIRE(cycle == serial_cycle);
+    }
+  }
+}
+
+TEST_CASE("Hamiltonian Search Prunes Hopeless Paths", "[HamiltonianCycle]") {
+  std::mt19937 generator(122);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  std::vector<Graph::VertexData*> cycle;
+  size_t num_explored = 0;
+
+  // a complete graph has (n - 1)! paths from the start, most of which can't beat the largest cycle
+  Graph complete;
+  for (int id = 0; id < 9; ++id) {
+    complete.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+    for (int other = 0; other < id; ++other) {
+      complete.insertEdge(complete.getVertex(id), complete.getVertex(other));
+    }
+  }
+  double complete_weight = complete.findLargestHamiltonianCycle(&cycle, 1, &num_explored);
+  requireHamiltonianCycle(complete, cycle, complete_weight);
+  REQUIRE(complete_weight == Approx(complete.getLargestHamiltonianCycleHeldKarp(&cycle, 1)));
+  REQUIRE(num_explored > 0);
+  REQUIRE(num_explored < 8 * 7 * 6 * 5 * 4 * 3 * 2);
+
+  // a vertex with one neighbor means there is no cycle to look for
+  complete.insertVertex(Graph::Station(9, 0, 0));
+  complete.insertEdge(complete.getVertex(9), complete.getVertex(0));
+  REQUIRE(complete.findLargestHamiltonianCycle(&cycle, 2, &num_explored) == -std::numeric_limits<double>::infinity());
+  REQUIRE(cycle.empty());
+  REQUIRE(num_explored == 0);
+
+  // two complete halves joined by one vertex can't be visited in one cycle, which is found without
+  // trying the orders of the second half after each order of the first
+  Graph halves;
+  for (int id = 0; id < 13; ++id) {
+    halves.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+  }
+  for (int id = 0; id < 13; ++id) {
+    for (int other = 0; other < id; ++other) {
+      if ((id <= 6 && other <= 6) || (id >= 6 && other >= 6)) {
+        halves.insertEdge(halves.getVertex(id), halves.getVertex(other));
+      }
+    }
+  }
+  REQUIRE(halves.findLargestHamiltonianCycle(&cycle, 1, &num_explored) == -std::numeric_limits<double>::infinity());
+  REQUIRE(num_explored < 7 * 6 * 5 * 4 * 3 * 2);
+
+  // the pruned search still finds the largest cycle of denser random graphs
+  for (int num_verticies = 10; num_verticies <= 13; ++num_verticies) {
+    Graph graph;
+    for (int id = 0; id < num_verticies; ++id) {
+      graph.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+    }
+    for (int i = 0; i < num_verticies * 4; ++i) {
+      graph.insertEdgeFromData(graph.getVertex(generator() % num_verticies), graph.getVertex(generator() % num_verticies));
+    }
+    double cycle_weight = graph.findLargestHamiltonianCycle(&cycle, 4, &num_explored);
+    std::vector<Graph::VertexData*> held_karp_cycle;
+    double held_karp_weight = graph.getLargestHamiltonianCycleHeldKarp(&held_karp_cycle, 1);
+    if (held_karp_cycle.empty()) {
+      REQUIRE(cycle.empty());
+      continue;
+    }
+    REQUIRE(cycle_weight == Approx(held_karp_weight));
+    requireHamiltonianCycle(graph, cycle, cycle_weight);
+  }
+}
+
+TEST_CASE("Long Hamiltonian Cycle Heuristic", "[HamiltonianCycle][LongCycle]") {
+  Graph::LongCycleBudget budget;
+  budget.seconds_ = 0;
+  budget.num_restarts_ = 8;
+  budget.num_threads_ = 2;
+  std::vector<Graph::VertexData*> cycle;
+
+  // small graphs: the heuristic finds the largest cycle (or no cycle if there is none)
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    std::vector<Graph::VertexData*> largest_cycle;
+    double largest_weight = graph.findLargestHamiltonianCycle(&largest_cycle, 1);
+    double cycle_weight = graph.findLongHamiltonianCycle(&cycle, budget);
+    if (largest_cycle.empty() || graph.size() < 3) {
+      REQUIRE(cycle.empty());
+      REQUIRE(graph.getLongHamiltonianCycle(budget) == nullptr);
+      continue;
+    }
+    requireHamiltonianCycle(graph, cycle, cycle_weight);
+    REQUIRE(cycle.front() == graph.getVertexMap().begin()->second);
+    REQUIRE(cycle_weight == Approx(largest_weight));
+    Graph* long_hamiltonian = graph.getLongHamiltonianCycle(budget);
+    REQUIRE(long_hamiltonian->size() == graph.size());
+    REQUIRE(long_hamiltonian->getEdgeList().size() == graph.size());
+    REQUIRE(long_hamiltonian->getTotalDistance() == Approx(cycle_weight));
+  }
+
+  // random graphs: any cycle found is a hamiltonian cycle no longer than the largest one
+  std::mt19937 generator(123);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  for (int num_verticies = 5; num_verticies <= 12; ++num_verticies) {
+    Graph graph;
+    for (int id = 0; id < num_verticies; ++id) {
+      graph.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+    }
+    for (int i = 0; i < num_verticies * 3; ++i) {
+      graph.insertEdgeFromData(graph.getVertex(generator() % num_verticies), graph.getVertex(generator() % num_verticies));
+    }
+    std::vector<Graph::VertexData*> largest_cycle;
+    double largest_weight = graph.findLargestHamiltonianCycle(&largest_cycle, 1);
+    double cycle_weight = graph.findLongHamiltonianCycle(&cycle, budget);
+    if (cycle.empty()) {
+      continue;
+    }
+    requireHamiltonianCycle(graph, cycle, cycle_weight);
+    REQUIRE(cycle_weight <= largest_weight * (1 + 1e-9));
+  }
+
+  // a larger complete graph: the same restarts give the same cycle on any number of threads, and
+  // more restarts never give a shorter cycle
+  Graph complete;
+  for (int id = 0; id < 60; ++id) {
+    complete.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+    for (int other = 0; other < id; ++other) {
+      complete.insertEdge(complete.getVertex(id), complete.getVertex(other));
+    }
+  }
+  size_t num_restarts = 0;
+  budget.num_threads_ = 1;
+  double serial_weight = complete.findLongHamiltonianCycle(&cycle, budget, &num_restarts);
+  requireHamiltonianCycle(complete, cycle, serial_weight);
+  REQUIRE(num_restarts == 8);
+  std::vector<Graph::VertexData*> serial_cycle = cycle;
+  budget.num_threads_ = 3;
+  REQUIRE(complete.findLongHamiltonianCycle(&cycle, budget) == serial_weight);
+  REQUIRE(cycle == serial_cycle);
+  budget.num_restarts_ = 1;
+  REQUIRE(complete.findLongHamiltonianCycle(&cycle, budget) <= serial_weight);
+
+  // a time budget always runs the first restart
+  budget.seconds_ = 1e-9;
+  budget.num_restarts_ = 0;
+  double timed_weight = complete.findLongHamiltonianCycle(&cycle, budget, &num_restarts);
+  REQUIRE(num_restarts >= 1);
+  requireHamiltonianCycle(complete, cycle, timed_weight);
+}
+
+TEST_CASE("Held-Karp Matches Hamiltonian Search", "[HamiltonianCycle][HeldKarp]") {
+  std::vector<Graph::VertexData*> cycle;
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    Graph* largest_hamiltonian = graph.getLargestHamiltonianCycle();
+    for (size_t num_threads : {1, 3}) {
+      double cycle_weight = graph.getLargestHamiltonianCycleHeldKarp(&cycle, num_threads);
+      if (largest_hamiltonian == nullptr) {
+        REQUIRE(cycle_weight == -std::numeric_limits<double>::infinity());
+        REQUIRE(cycle.empty());
+        continue;
+      }
+      REQUIRE(cycle_weight == Approx(largest_hamiltonian->getTotalDistance()));
+      REQUIRE(cycle.front() == graph.getVertexMap().begin()->second);
+      requireHamiltonianCycle(graph, cycle, cycle_weight);
+    }
+  }
+}
+
+TEST_CASE("Held-Karp On Random Graphs", "[HamiltonianCycle][HeldKarp]") {
+  std::mt19937 generator(120);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  std::vector<Graph::VertexData*> cycle;
+  for (int num_verticies = 3; num_verticies <= 10; ++num_verticies) {
+    Graph graph;
+    for (int id = 0; id < num_verticies; ++id) {
+      graph.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+    }
+    for (int i = 0; i < num_verticies * 3; ++i) {
+      graph.insertEdgeFromData(graph.getVertex(generator() % num_verticies), graph.getVertex(generator() % num_verticies));
+    }
+    Graph* largest_hamiltonian = graph.getLargestHamiltonianCycle();
+    double cycle_weight = graph.getLargestHamiltonianCycleHeldKarp(&cycle, 2);
+    if (largest_hamiltonian == nullptr) {
+      REQUIRE(cycle_weight == -std::numeric_limits<double>::infinity());
+      continue;
+    }
+    REQUIRE(cycle_weight == Approx(largest_hamiltonian->getTotalDistance()));
+    requireHamiltonianCycle(graph, cycle, cycle_weight);
+  }
+
+  // a complete graph always has a cycle, and too many verticies aren't solved
+  Graph complete;
+  for (int id = 0; id < 16; ++id) {
+    complete.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+    for (int other = 0; other < id; ++other) {
+      complete.insertEdge(complete.getVertex(id), complete.getVertex(other));
+    }
+  }
+  double complete_weight = complete.getLargestHamiltonianCycleHeldKarp(&cycle, 4);
+  requireHamiltonianCycle(complete, cycle, complete_weight);
+  REQUIRE(complete_weight == complete.getLargestHamiltonianCycleHeldKarp(&cycle, 1));
+  for (int id = 16; id < static_cast<int>(Graph::kMaxHeldKarpVerticies) + 1; ++id) {
+    complete.insertVertex(Graph::Station(id, 0, 0));
+  }
+  REQUIRE(complete.getLargestHamiltonianCycleHeldKarp(&cycle) == -std::numeric_limits<double>::infinity());
+  REQUIRE(cycle.empty());
+}
+
 /**
  * Test Remove Edge
  */
@@ -770,6 +1736,39 @@ TEST_CASE("Test Remove Multiple Verticies", "[valgrind][RemoveVertex][size]") {
   delete test_graph;
 }
 
+TEST_CASE("Vertex Indices Stay Dense", "[valgrind][RemoveVertex][vertexIndex]") {
+  Graph test_graph;
+  test_graph.addDataFromFile("tests/test_data/traversal2_dat.csv");
+  test_graph.removeVertex(test_graph.getVertex(1));
+  test_graph.insertVertex(Graph::Station(40, 0, 0));
+  test_graph.removeVertex(test_graph.getVertex(3));
+
+  Graph copied_graph(test_graph);
+  for (Graph* graph : {&test_graph, &copied_graph}) {
+    REQUIRE(graph->getVertexList().size() == 4);
+    for (uint32_t index = 0; index < graph->size(); ++index) {
+      Graph::VertexData* vertex = graph->getVertexByIndex(index);
+      REQUIRE(vertex->index_ == index);
+      REQUIRE(graph->getVertex(vertex->station_.id_) == vertex);
+    }
+    REQUIRE(graph->getVertex(1) == nullptr);
+    REQUIRE(graph->getVertex(3) == nullptr);
+    REQUIRE(graph->getVertex(40) != nullptr);
+    // edges are kept dense the same way
+    std::list<Graph::Edge*> edges = graph->getEdgeList();
+    REQUIRE(graph->getNumEdges() == edges.size());
+    uint32_t edge_index = 0;
+    for (Graph::Edge* edge : edges) {
+      REQUIRE(edge->index_ == edge_index);
+      ++edge_index;
+    }
+  }
+  // copies keep the index of every vertex
+  for (Graph::VertexData* vertex : test_graph.getVertexList()) {
+    REQUIRE(copied_graph.getVertex(vertex->station_.id_)->index_ == vertex->index_);
+  }
+}
+
 /**
  * Test find Northwest Most & Southeast Most Stations
  */
@@ -789,6 +1788,22 @@ TEST_CASE("Check SoutheastMost", "[SoutheastMost]") {
   REQUIRE(south_e_most->station_.id_ == 3);
 }
 
+TEST_CASE("NorthwestMost And SoutheastMost Do Not Depend On Insertion Order", "[NorthwestMost][SoutheastMost]") {
+  // the stations are compared in order of station id, whatever order they were inserted in
+  std::vector<Graph::Station> stations = {Graph::Station(0, 5, 5), Graph::Station(3, 10, 4),
+      Graph::Station(1, 7, 1), Graph::Station(4, 0, 8), Graph::Station(2, 1, 9), Graph::Station(5, 8, 8)};
+  for (int i = 0; i < 2; ++i) {
+    Graph graph;
+    REQUIRE(graph.getNorthwestMost() == nullptr);
+    for (const Graph::Station& station : stations) {
+      graph.insertVertex(station);
+    }
+    REQUIRE(graph.getNorthwestMost()->station_.id_ == 1);
+    REQUIRE(graph.getSoutheastMost()->station_.id_ == 2);
+    std::reverse(stations.begin(), stations.end());
+  }
+}
+
 /**
  * Test Edge Distance
  */
@@ -827,9 +1842,9 @@ TEST_CASE("Test Basic Dijkstra's", "[valgrind][Dijkstras]") {
 
   Graph::VertexData* first = test_graph->getVertex(0);
 
-  std::pair<Graph, std::map<int, Graph::VertexData*>> dijkstras_result = test_graph->Dijkstras(first);
+  Graph::ShortestPathTree dijkstras_result = test_graph->Dijkstras(first);
 
-  Graph result = dijkstras_result.first;
+  const Graph& result = dijkstras_result.toGraph();
   REQUIRE(result.size() == 4);
   REQUIRE(result.getEdgeList().size() == 3);
 
@@ -847,11 +1862,11 @@ TEST_CASE("Test Basic Dijkstra's", "[valgrind][Dijkstras]") {
     expected_edges.pop_back();
   }
 
-  for (std::pair<int, Graph::VertexData*> vertex : dijkstras_result.second) {
+  for (std::pair<int, Graph::VertexData*> vertex : test_graph->getVertexMap()) {
     if (vertex.first == 0) {
-      REQUIRE(vertex.second == nullptr);
+      REQUIRE(dijkstras_result.getParent(vertex.second) == nullptr);
     } else  {
-      REQUIRE(vertex.second->station_.id_ == 0);
+      REQUIRE(dijkstras_result.getParent(vertex.second)->station_.id_ == 0);
     }
   }
   delete test_graph;
@@ -863,8 +1878,8 @@ TEST_CASE("Test Dijkstra's", "[valgrind][Dijkstras][Tiebreaks]") {
 
   Graph::VertexData* first = test_graph->getVertex(4);
 
-  std::pair<Graph, std::map<int, Graph::VertexData*>> dijkstras_result = test_graph->Dijkstras(first);
-  Graph result = dijkstras_result.first;
+  Graph::ShortestPathTree dijkstras_result = test_graph->Dijkstras(first);
+  const Graph& result = dijkstras_result.toGraph();
 
   REQUIRE(result.size() == 5);
   REQUIRE(result.getEdgeList().size() == 4);
@@ -886,13 +1901,1012 @@ TEST_CASE("Test Dijkstra's", "[valgrind][Dijkstras][Tiebreaks]") {
   }
 
   std::vector<int> expected_previous_stations = {1, 1, 4, 4};
-  for (std::pair<int, Graph::VertexData*> vertex : dijkstras_result.second) {
+  for (std::pair<int, Graph::VertexData*> vertex : test_graph->getVertexMap()) {
     if (vertex.first == 4) {
-      REQUIRE(vertex.second == nullptr);
+      REQUIRE(dijkstras_result.getParent(vertex.second) == nullptr);
     } else  {
-      REQUIRE(vertex.second->station_.id_ == expected_previous_stations.back());
+      REQUIRE(dijkstras_result.getParent(vertex.second)->station_.id_ == expected_previous_stations.back());
       expected_previous_stations.pop_back();
     }
   }
   delete test_graph;
 }
+
+TEST_CASE("Shortest Path Tree", "[valgrind][Dijkstras][ShortestPathTree]") {
+  Graph test_graph;
+  test_graph.addDataFromFile("tests/test_data/traversal3_dat.csv");
+  Graph::VertexData* start = test_graph.getVertex(0);
+  Graph::ShortestPathTree tree = test_graph.Dijkstras(start);
+  REQUIRE(tree.getSource() == start);
+  REQUIRE(tree.getDistance(start) == 0);
+  REQUIRE(tree.getParent(start) == nullptr);
+  REQUIRE(tree.getDistances().size() == test_graph.size());
+  REQUIRE(tree.getParents().size() == test_graph.size());
+
+  // the tree is only built as a Graph once, and copies of the tree share it
+  const Graph& tree_graph = tree.toGraph();
+  REQUIRE(&tree.toGraph() == &tree_graph);
+  Graph::ShortestPathTree copied_tree = tree;
+  REQUIRE(&copied_tree.toGraph() == &tree_graph);
+  REQUIRE(tree_graph.size() == test_graph.size());
+
+  // each reachable vertex has one edge to its parent, and unreachable verticies have none
+  size_t num_reachable = 0;
+  std::vector<Graph::VertexData*> path;
+  for (Graph::VertexData* vertex : test_graph.getVertexList()) {
+    double distance = tree.getPath(vertex, &path);
+    REQUIRE(distance == tree.getDistance(vertex));
+    if (std::isinf(distance)) {
+      REQUIRE(path.empty());
+      REQUIRE(tree.getParent(vertex) == nullptr);
+      continue;
+    }
+    num_reachable += 1;
+    REQUIRE(path.front() == start);
+    REQUIRE(path.back() == vertex);
+  }
+  REQUIRE(num_reachable < test_graph.size());
+  REQUIRE(tree_graph.getNumEdges() == num_reachable - 1);
+
+  // an empty tree has an empty graph
+  Graph::ShortestPathTree empty_tree;
+  REQUIRE(empty_tree.getSource() == nullptr);
+  REQUIRE(empty_tree.toGraph().size() == 0);
+}
+
+TEST_CASE("Shortest Path Tree Graph Is Built Once Across Threads", "[Dijkstras][ShortestPathTree]") {
+  Graph test_graph;
+  test_graph.addDataFromFile("tests/test_data/traversal3_dat.csv");
+  Graph::ShortestPathTree tree = test_graph.Dijkstras(test_graph.getVertex(0));
+  // copies made before the graph is built share it too
+  Graph::ShortestPathTree copied_tree = tree;
+
+  const size_t kNumThreads = 4;
+  std::vector<const Graph*> tree_graphs(kNumThreads, nullptr);
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    workers.emplace_back([&, i]() {
+      tree_graphs[i] = &(i % 2 == 0 ? tree : copied_tree).toGraph();
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (const Graph* tree_graph : tree_graphs) {
+    REQUIRE(tree_graph == &tree.toGraph());
+  }
+  REQUIRE(tree.toGraph().size() == test_graph.size());
+}
+
+/**
+ * Test Static (CSR) Graph
+ */
+TEST_CASE("Static Graph Has Same Verticies And Edges", "[StaticGraph]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    StaticGraph frozen = graph.freeze();
+
+    REQUIRE(frozen.size() == graph.size());
+    REQUIRE(frozen.getNumEdges() == graph.getEdgeList().size());
+    REQUIRE(frozen.getTotalWeight() == Approx(graph.getTotalDistance()));
+    for (std::pair<int, Graph::VertexData*> vertex : graph.getVertexMap()) {
+      uint32_t index = frozen.getVertexIndex(vertex.first);
+      REQUIRE(index != StaticGraph::kNoVertex);
+      REQUIRE(areStationsEqual(frozen.getStation(index), vertex.second->station_));
+      REQUIRE(frozen.getDegree(index) == vertex.second->adjacent_edges_.size());
+      for (uint32_t i = 0; i < frozen.getDegree(index); ++i) {
+        Graph::VertexData* neighbor = graph.getVertex(frozen.getStation(frozen.getNeighbors(index)[i]).id_);
+        Graph::Edge* edge = graph.getEdge(vertex.second, neighbor);
+        REQUIRE(edge != nullptr);
+        REQUIRE(frozen.getWeights(index)[i] == edge->getEdgeDistance());
+      }
+    }
+    REQUIRE(frozen.getVertexIndex(-5) == StaticGraph::kNoVertex);
+  }
+}
+
+TEST_CASE("Static Graph DFS Matches DFS", "[StaticGraph][DFS]") {
+  std::vector<std::string> files = {"tests/test_data/traversal1_dat.csv", "tests/test_data/traversal2_dat.csv",
+      "tests/test_data/traversal3_dat.csv", "tests/test_data/traversal4_dat.csv"};
+  for (const std::string& file : files) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    StaticGraph frozen = graph.freeze();
+
+    DFS traversal = DFS(&graph, graph.getVertex(0));
+    std::vector<int> expected_stations;
+    for (auto it = traversal.begin(); it != traversal.end(); ++it) {
+      expected_stations.push_back((*it)->station_.id_);
+    }
+    size_t num_connected_components = 0;
+    std::vector<uint32_t> frozen_traversal = frozen.DFS(frozen.getVertexIndex(0), &num_connected_components);
+    REQUIRE(frozen_traversal.size() == expected_stations.size());
+    for (size_t i = 0; i < frozen_traversal.size(); ++i) {
+      REQUIRE(frozen.getStation(frozen_traversal[i]).id_ == expected_stations[i]);
+    }
+    REQUIRE(num_connected_components == traversal.getNumConnectedComponents());
+    REQUIRE(frozen.getNumConnectedComponents() == traversal.getNumConnectedComponents());
+  }
+}
+
+TEST_CASE("Static Graph Connectivity And Eulerian", "[StaticGraph][checkConnected][checkEulerian]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    StaticGraph frozen = graph.freeze();
+    REQUIRE(frozen.isConnected() == graph.isConnected());
+    REQUIRE(frozen.isEulerian() == graph.isEulerian());
+  }
+  StaticGraph empty;
+  REQUIRE_FALSE(empty.isConnected());
+  REQUIRE(empty.isEulerian() == 0);
+}
+
+TEST_CASE("Static Graph Dijkstra's Matches Dijkstra's", "[StaticGraph][Dijkstras]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    StaticGraph frozen = graph.freeze();
+    for (std::pair<int, Graph::VertexData*> start : graph.getVertexMap()) {
+      Graph::ShortestPathTree tree = graph.Dijkstras(start.second);
+      std::map<int, double> expected_distances;
+      for (std::pair<int, Graph::VertexData*> vertex : graph.getVertexMap()) {
+        expected_distances[vertex.first] = tree.getDistance(vertex.second);
+      }
+
+      std::vector<double> distances;
+      std::vector<uint32_t> previous;
+      frozen.Dijkstras(frozen.getVertexIndex(start.first), &distances, &previous);
+      for (uint32_t vertex = 0; vertex < frozen.size(); ++vertex) {
+        int station_id = frozen.getStation(vertex).id_;
+        if (std::isinf(expected_distances[station_id])) {
+          REQUIRE(std::isinf(distances[vertex]));
+          REQUIRE(previous[vertex] == StaticGraph::kNoVertex);
+        } else {
+          REQUIRE(distances[vertex] == Approx(expected_distances[station_id]));
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Test Binary Snapshots
+ */
+TEST_CASE("Snapshot Round Trip", "[valgrind][snapshot]") {
+  const std::string kSnapshotPath = "tests/test_data/round_trip.snapshot";
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    REQUIRE(graph.saveSnapshot(kSnapshotPath));
+
+    Graph loaded;
+    REQUIRE(loaded.loadSnapshot(kSnapshotPath));
+    requireGraphsEqual(graph, loaded);
+    requireAllEdgeStatsEqual(graph, loaded);
+  }
+  unlink(kSnapshotPath.c_str());
+}
+
+TEST_CASE("Snapshot Is Used In Place By StaticGraph", "[snapshot][StaticGraph]") {
+  const std::string kSnapshotPath = "tests/test_data/static.snapshot";
+  Graph graph;
+  for (const std::string& file : kTestDataFiles) {
+    graph.addDataFromFile(file);
+  }
+  REQUIRE(graph.saveSnapshot(kSnapshotPath));
+  StaticGraph expected = graph.freeze();
+
+  StaticGraph* loaded = new StaticGraph();
+  REQUIRE(loaded->loadSnapshot(kSnapshotPath));
+  REQUIRE(loaded->isMapped());
+  REQUIRE_FALSE(expected.isMapped());
+  // copies share the mapping, which outlives the graph it was loaded into
+  StaticGraph copied = *loaded;
+  delete loaded;
+  unlink(kSnapshotPath.c_str());
+
+  REQUIRE(copied.size() == expected.size());
+  REQUIRE(copied.getNumEdges() == expected.getNumEdges());
+  REQUIRE(copied.getTotalWeight() == expected.getTotalWeight());
+  for (uint32_t vertex = 0; vertex < expected.size(); ++vertex) {
+    REQUIRE(areStationsEqual(copied.getStation(vertex), expected.getStation(vertex)));
+    REQUIRE(copied.getDegree(vertex) == expected.getDegree(vertex));
+    for (uint32_t i = 0; i < expected.getDegree(vertex); ++i) {
+      REQUIRE(copied.getNeighbors(vertex)[i] == expected.getNeighbors(vertex)[i]);
+      REQUIRE(copied.getWeights(vertex)[i] == expected.getWeights(vertex)[i]);
+    }
+  }
+  REQUIRE(copied.DFS(0, nullptr) == expected.DFS(0, nullptr));
+  REQUIRE(copied.isEulerian() == expected.isEulerian());
+}
+
+TEST_CASE("Invalid Snapshots Are Not Loaded", "[snapshot]") {
+  const std::string kSnapshotPath = "tests/test_data/invalid.snapshot";
+  Graph graph;
+  graph.addDataFromFile("tests/test_data/traversal2_dat.csv");
+  REQUIRE(graph.saveSnapshot(kSnapshotPath));
+  std::string contents;
+  {
+    std::ifstream snapshot_file(kSnapshotPath, std::ios::binary);
+    std::stringstream buffer;
+    buffer << snapshot_file.rdbuf();
+    contents = buffer.str();
+  }
+  auto write_snapshot = [&](const std::string& data) {
+    std::ofstream snapshot_file(kSnapshotPath, std::ios::binary | std::ios::trunc);
+    snapshot_file << data;
+  };
+
+  std::string corrupted = contents;
+  corrupted[corrupted.size() - 3] ^= 1;
+  std::string wrong_version = contents;
+  wrong_version[8] += 1;
+  std::vector<std::string> invalid_snapshots = {corrupted, wrong_version, contents.substr(0, contents.size() - 8),
+      contents.substr(0, 20), "not a snapshot"};
+  for (const std::string& invalid : invalid_snapshots) {
+    write_snapshot(invalid);
+    Graph loaded;
+    REQUIRE_FALSE(loaded.loadSnapshot(kSnapshotPath));
+    REQUIRE(loaded.size() == 0);
+    StaticGraph frozen;
+    REQUIRE_FALSE(frozen.loadSnapshot(kSnapshotPath));
+    REQUIRE(frozen.size() == 0);
+  }
+  unlink(kSnapshotPath.c_str());
+
+  Graph loaded;
+  REQUIRE_FALSE(loaded.loadSnapshot("tests/test_data/missing.snapshot"));
+}
+
+TEST_CASE("Snapshots Record The Data Files They Were Built From", "[snapshot]") {
+  const std::string kSnapshotPath = "tests/test_data/sources.snapshot";
+  const std::vector<std::string> kSourcePaths = {"tests/test_data/sources_one.csv", "tests/test_data/sources_two.csv"};
+  auto write_file = [](const std::string& file_path, const std::string& contents) {
+    std::ofstream data_file(file_path, std::ios::trunc);
+    data_file << contents;
+  };
+  write_file(kSourcePaths[0], "header\n");
+  unlink(kSourcePaths[1].c_str());
+
+  Graph graph;
+  graph.addDataFromFile("tests/test_data/traversal2_dat.csv");
+  REQUIRE(graph.saveSnapshot(kSnapshotPath, kSourcePaths));
+  {
+    Snapshot snapshot(kSnapshotPath);
+    REQUIRE(snapshot.isValid());
+    REQUIRE(snapshot.getHeader().num_source_files_ == 1);
+    REQUIRE(std::string(snapshot.getSourceFiles()[0].path_) == kSourcePaths[0]);
+    REQUIRE(snapshot.getSourceFiles()[0].size_ == 7);
+    REQUIRE(snapshot.isBuiltFrom(kSourcePaths));
+    // a file missing from the list given (even one that exists) makes the lists differ
+    REQUIRE_FALSE(snapshot.isBuiltFrom({}));
+  }
+  Graph loaded;
+  REQUIRE(loaded.loadSnapshot(kSnapshotPath));
+  requireGraphsEqual(graph, loaded);
+
+  // a data file that appears later, whatever its modification time
+  write_file(kSourcePaths[1], "header\n");
+  REQUIRE_FALSE(Snapshot(kSnapshotPath).isBuiltFrom(kSourcePaths));
+  unlink(kSourcePaths[1].c_str());
+  REQUIRE(Snapshot(kSnapshotPath).isBuiltFrom(kSourcePaths));
+  // a data file that changes size
+  write_file(kSourcePaths[0], "header\nrow\n");
+  REQUIRE_FALSE(Snapshot(kSnapshotPath).isBuiltFrom(kSourcePaths));
+  // a data file that is removed
+  unlink(kSourcePaths[0].c_str());
+  REQUIRE_FALSE(Snapshot(kSnapshotPath).isBuiltFrom(kSourcePaths));
+  REQUIRE_FALSE(Snapshot("tests/test_data/missing.snapshot").isBuiltFrom({}));
+  unlink(kSnapshotPath.c_str());
+}
+
+TEST_CASE("Snapshots With Indices Out Of Range Are Not Loaded", "[snapshot]") {
+  const std::string kSnapshotPath = "tests/test_data/out_of_range.snapshot";
+  Graph graph;
+  graph.addDataFromFile("tests/test_data/traversal2_dat.csv");
+  REQUIRE(graph.saveSnapshot(kSnapshotPath));
+  std::string contents;
+  {
+    std::ifstream snapshot_file(kSnapshotPath, std::ios::binary);
+    std::stringstream buffer;
+    buffer << snapshot_file.rdbuf();
+    contents = buffer.str();
+  }
+  Snapshot::Header header;
+  std::memcpy(&header, contents.data(), sizeof(header));
+  REQUIRE(header.num_verticies_ > 2);
+  // sections start on 8 byte boundaries (see Snapshot)
+  size_t offsets_start = sizeof(Snapshot::Header) + (header.num_verticies_ * sizeof(Graph::Station) + 7) / 8 * 8;
+  size_t neighbors_start = offsets_start + ((header.num_verticies_ + 1) * sizeof(uint32_t) + 7) / 8 * 8;
+
+  // change a uint32_t in the file, and write it with a checksum that matches again
+  auto write_snapshot = [&](size_t position, uint32_t value) {
+    std::string changed = contents;
+    std::memcpy(&changed[position], &value, sizeof(value));
+    Snapshot::Header changed_header = header;
+    changed_header.checksum_ = Snapshot::computeChecksum(changed.data() + sizeof(Snapshot::Header),
+        changed.data() + changed.size());
+    std::memcpy(&changed[0], &changed_header, sizeof(changed_header));
+    std::ofstream snapshot_file(kSnapshotPath, std::ios::binary | std::ios::trunc);
+    snapshot_file << changed;
+  };
+
+  // a neighbor that isn't a vertex
+  write_snapshot(neighbors_start, static_cast<uint32_t>(header.num_verticies_));
+  REQUIRE_FALSE(Snapshot(kSnapshotPath).isValid());
+  StaticGraph frozen;
+  REQUIRE_FALSE(frozen.loadSnapshot(kSnapshotPath));
+  // offsets that go backwards (the second vertex's neighbors end before they start)
+  write_snapshot(offsets_start + sizeof(uint32_t), static_cast<uint32_t>(header.num_adjacencies_));
+  REQUIRE_FALSE(Snapshot(kSnapshotPath).isValid());
+  Graph loaded;
+  REQUIRE_FALSE(loaded.loadSnapshot(kSnapshotPath));
+  // the same file with its own neighbor (and a recomputed checksum) is still valid
+  uint32_t neighbor;
+  std::memcpy(&neighbor, &contents[neighbors_start], sizeof(neighbor));
+  write_snapshot(neighbors_start, neighbor);
+  REQUIRE(Snapshot(kSnapshotPath).isValid());
+  unlink(kSnapshotPath.c_str());
+}
+
+/**
+ * Test Vertex Heaps
+ */
+template <typename Heap>
+void requireHeapPopsInKeyOrder() {
+  std::mt19937 generator(225);
+  std::uniform_real_distribution<double> key_distribution(0, 100);
+  const size_t kNumVerticies = 500;
+  std::vector<double> keys(kNumVerticies, std::numeric_limits<double>::infinity());
+  Heap heap;
+  heap.reset(kNumVerticies);
+  REQUIRE(heap.empty());
+  // push every vertex, then lower the keys of some of them (some more than once)
+  for (uint32_t vertex = 0; vertex < kNumVerticies; ++vertex) {
+    keys[vertex] = key_distribution(generator);
+    heap.push(vertex, keys[vertex]);
+  }
+  for (size_t i = 0; i < kNumVerticies; ++i) {
+    uint32_t vertex = static_cast<uint32_t>(generator() % kNumVerticies);
+    keys[vertex] = keys[vertex] / 2;
+    heap.push(vertex, keys[vertex]);
+  }
+
+  std::vector<bool> is_popped(kNumVerticies, false);
+  double previous_key = -1;
+  for (size_t i = 0; i < kNumVerticies; ++i) {
+    REQUIRE_FALSE(heap.empty());
+    uint32_t vertex = heap.pop();
+    REQUIRE_FALSE(is_popped[vertex]);
+    is_popped[vertex] = true;
+    REQUIRE(keys[vertex] >= previous_key);
+    previous_key = keys[vertex];
+  }
+  REQUIRE(heap.empty());
+}
+
+TEST_CASE("Vertex Heaps Pop In Key Order", "[Dijkstras][heap]") {
+  requireHeapPopsInKeyOrder<DaryHeap<2>>();
+  requireHeapPopsInKeyOrder<DaryHeap<4>>();
+  requireHeapPopsInKeyOrder<DaryHeap<8>>();
+  requireHeapPopsInKeyOrder<LazyBinaryHeap>();
+  requireHeapPopsInKeyOrder<FibonacciHeap>();
+}
+
+TEST_CASE("Dijkstra's Gives The Same Distances With Every Heap", "[Dijkstras][heap]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    StaticGraph frozen = graph.freeze();
+    for (Graph::VertexData* start : graph.getVertexList()) {
+      std::vector<double> expected_distances;
+      graph.Dijkstras<Graph::GeometricDistance, FibonacciHeap>(start, &expected_distances, nullptr);
+      std::vector<double> graph_distances;
+      graph.Dijkstras<Graph::GeometricDistance, LazyBinaryHeap>(start, &graph_distances, nullptr);
+      REQUIRE(graph_distances == expected_distances);
+      graph.Dijkstras(start, &graph_distances, nullptr);
+      REQUIRE(graph_distances == expected_distances);
+      Graph::ShortestPathTree with_lazy_heap = graph.Dijkstras<Graph::GeometricDistance, LazyBinaryHeap>(start);
+      REQUIRE(with_lazy_heap.getDistances() == expected_distances);
+      // every vertex (reachable or not) is in the tree
+      REQUIRE(with_lazy_heap.toGraph().size() == graph.size());
+
+      std::vector<double> fibonacci_distances;
+      std::vector<double> dary_distances;
+      std::vector<uint32_t> previous;
+      uint32_t frozen_start = frozen.getVertexIndex(start->station_.id_);
+      frozen.Dijkstras<FibonacciHeap>(frozen_start, &fibonacci_distances, &previous);
+      frozen.Dijkstras<DaryHeap<2>>(frozen_start, &dary_distances, &previous);
+      REQUIRE(fibonacci_distances == dary_distances);
+    }
+  }
+}
+
+/**
+ * Test Point To Point Shortest Paths
+ */
+TEST_CASE("Shortest Path Matches Dijkstra's", "[Dijkstras][shortestPath]") {
+  std::vector<Graph::VertexData*> path;
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    for (Graph::VertexData* source : graph.getVertexList()) {
+      Graph::ShortestPathTree tree = graph.Dijkstras(source);
+      std::vector<Graph::VertexData*> tree_path;
+
+      for (Graph::VertexData* target : graph.getVertexList()) {
+        double cost = graph.shortestPath(source, target, &path);
+        REQUIRE(cost == tree.getDistance(target));
+        REQUIRE(tree.getPath(target, &tree_path) == cost);
+        if (std::isinf(cost)) {
+          REQUIRE(path.empty());
+          REQUIRE(tree_path.empty());
+          continue;
+        }
+        // the path is the one Dijkstra's previous verticies lead back along
+        std::vector<Graph::VertexData*> expected_path = {target};
+        while (tree.getParent(expected_path.back()) != nullptr) {
+          expected_path.push_back(tree.getParent(expected_path.back()));
+        }
+        std::reverse(expected_path.begin(), expected_path.end());
+        REQUIRE(path == expected_path);
+        REQUIRE(tree_path == expected_path);
+
+        double path_weight = 0;
+        for (size_t i = 1; i < path.size(); ++i) {
+          Graph::Edge* edge = graph.getEdge(path[i - 1], path[i]);
+          REQUIRE(edge != nullptr);
+          path_weight += edge->getEdgeDistance();
+        }
+        REQUIRE(path_weight == cost);
+      }
+    }
+  }
+}
+
+TEST_CASE("Shortest Path Edge Cases", "[shortestPath]") {
+  Graph graph;
+  graph.addDataFromFile("tests/test_data/traversal2_dat.csv");
+  graph.insertVertex(Graph::Station(50, 0, 0));
+  std::vector<Graph::VertexData*> path = {graph.getVertex(1), graph.getVertex(2)};
+
+  // a path from a vertex to itself is just the vertex
+  REQUIRE(graph.shortestPath(graph.getVertex(0), graph.getVertex(0), &path) == 0);
+  REQUIRE(path == std::vector<Graph::VertexData*>({graph.getVertex(0)}));
+
+  // an unreachable vertex has no path
+  REQUIRE(std::isinf(graph.shortestPath(graph.getVertex(0), graph.getVertex(50), &path)));
+  REQUIRE(path.empty());
+
+  // trip based weights and other heaps (0 to 1 has a mean of 110 seconds, 1 to 2 has 100)
+  Graph with_stats;
+  with_stats.addDataFromFile("tests/test_data/trip_stats_dat.csv");
+  double cost = with_stats.shortestPath<Graph::MeanDuration, FibonacciHeap>(with_stats.getVertex(0),
+      with_stats.getVertex(2), &path);
+  REQUIRE(cost == 210);
+  REQUIRE(path.size() == 3);
+  REQUIRE(path[1]->station_.id_ == 1);
+  REQUIRE(with_stats.shortestPath<Graph::MeanDuration, LazyBinaryHeap>(with_stats.getVertex(0),
+      with_stats.getVertex(2), &path) == 210);
+}
+
+/**
+ * Checks that a path joins the source to the target along edges of the graph, with the given cost
+ */
+void requirePathHasCost(Graph& graph, const std::vector<Graph::VertexData*>& path, Graph::VertexData* source,
+    Graph::VertexData* target, double cost) {
+  REQUIRE(path.front() == source);
+  REQUIRE(path.back() == target);
+  double path_weight = 0;
+  for (size_t i = 1; i < path.size(); ++i) {
+    Graph::Edge* edge = graph.getEdge(path[i - 1], path[i]);
+    REQUIRE(edge != nullptr);
+    path_weight += edge->getEdgeDistance();
+  }
+  REQUIRE(path_weight == cost);
+}
+
+TEST_CASE("Bidirectional Shortest Path Matches Shortest Path", "[Dijkstras][shortestPath][bidirectional]") {
+  std::vector<Graph::VertexData*> path;
+  std::vector<Graph::VertexData*> bidirectional_path;
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    for (Graph::VertexData* source : graph.getVertexList()) {
+      for (Graph::VertexData* target : graph.getVertexList()) {
+        double cost = graph.shortestPath(source, target, &path);
+        REQUIRE(graph.bidirectionalShortestPath(source, target, &bidirectional_path) == cost);
+        // the test graphs have several shortest paths between some stations, so the path may differ
+        if (std::isinf(cost)) {
+          REQUIRE(bidirectional_path.empty());
+        } else {
+          requirePathHasCost(graph, bidirectional_path, source, target, cost);
+        }
+        REQUIRE(graph.bidirectionalShortestPath<Graph::MeanDuration, LazyBinaryHeap>(source, target,
+            &bidirectional_path) == graph.shortestPath<Graph::MeanDuration>(source, target, &path));
+      }
+    }
+  }
+}
+
+TEST_CASE("Bidirectional Shortest Path Gives The Same Path", "[Dijkstras][shortestPath][bidirectional]") {
+  // random station coordinates, so there is only one shortest path between two stations
+  Graph graph;
+  std::mt19937 generator(225);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  for (int id = 0; id < 300; ++id) {
+    graph.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+  }
+  for (int i = 0; i < 900; ++i) {
+    graph.insertEdgeFromData(graph.getVertex(generator() % 300), graph.getVertex(generator() % 300));
+  }
+
+  std::vector<Graph::VertexData*> path;
+  std::vector<Graph::VertexData*> bidirectional_path;
+  for (int query = 0; query < 2000; ++query) {
+    Graph::VertexData* source = graph.getVertex(generator() % 300);
+    Graph::VertexData* target = graph.getVertex(generator() % 300);
+    REQUIRE(graph.bidirectionalShortestPath(source, target, &bidirectional_path)
+        == graph.shortestPath(source, target, &path));
+    REQUIRE(bidirectional_path == path);
+  }
+}
+
+TEST_CASE("Bidirectional Shortest Path Adds Up The Edges It Used", "[Dijkstras][shortestPath][bidirectional]") {
+  // two edges between stations 0 and 1, where the edge found by getEdge is the slower one
+  Graph graph;
+  Graph::VertexData* station_0 = graph.insertVertex(Graph::Station(0, 0, 0));
+  Graph::VertexData* station_1 = graph.insertVertex(Graph::Station(1, 0, 1));
+  Graph::VertexData* station_2 = graph.insertVertex(Graph::Station(2, 1, 1));
+  Graph::Trip trip;
+  trip.duration_ = 500;
+  graph.insertEdge(station_0, station_1)->stats_.addTrip(trip, true);
+  trip.duration_ = 100;
+  graph.insertEdge(station_0, station_1)->stats_.addTrip(trip, true);
+  trip.duration_ = 50;
+  graph.insertEdge(station_1, station_2)->stats_.addTrip(trip, true);
+  REQUIRE(graph.getEdge(station_0, station_1)->stats_.getMeanDuration() == 500);
+
+  std::vector<Graph::VertexData*> path;
+  std::vector<Graph::VertexData*> bidirectional_path;
+  REQUIRE(graph.shortestPath<Graph::MeanDuration>(station_0, station_2, &path) == 150);
+  REQUIRE(graph.bidirectionalShortestPath<Graph::MeanDuration>(station_0, station_2, &bidirectional_path) == 150);
+  REQUIRE(bidirectional_path == path);
+  REQUIRE(graph.bidirectionalShortestPath<Graph::MeanDuration>(station_2, station_0, &bidirectional_path) == 150);
+}
+
+TEST_CASE("Bidirectional Dijkstra's", "[valgrind][Dijkstras][Tiebreaks][bidirectional]") {
+  Graph* test_graph = new Graph();
+  test_graph->addDataFromFile("tests/test_data/dijkstra2_dat.csv");
+  Graph::VertexData* first = test_graph->getVertex(4);
+
+  // the same previous stations as "Test Dijkstra's" (3 is as close through 1 as through 2)
+  std::map<int, int> expected_previous_stations = {{0, 4}, {1, 4}, {2, 1}, {3, 1}};
+  std::vector<Graph::VertexData*> path;
+  for (std::pair<int, int> previous : expected_previous_stations) {
+    std::vector<Graph::VertexData*> expected_path = {test_graph->getVertex(previous.first)};
+    while (expected_path.back() != first) {
+      expected_path.push_back(test_graph->getVertex(expected_previous_stations[expected_path.back()->station_.id_]));
+    }
+    std::reverse(expected_path.begin(), expected_path.end());
+
+    double cost = test_graph->bidirectionalShortestPath(first, test_graph->getVertex(previous.first), &path);
+    REQUIRE(path == expected_path);
+    REQUIRE(cost == test_graph->shortestPath(first, test_graph->getVertex(previous.first), &path));
+    REQUIRE(path == expected_path);
+  }
+  delete test_graph;
+}
+
+TEST_CASE("A* Matches Shortest Path", "[Dijkstras][shortestPath][AStar]") {
+  std::vector<Graph::VertexData*> path;
+  std::vector<Graph::VertexData*> a_star_path;
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    for (Graph::VertexData* source : graph.getVertexList()) {
+      for (Graph::VertexData* target : graph.getVertexList()) {
+        double cost = graph.shortestPath(source, target, &path);
+        size_t num_settled = 0;
+        REQUIRE(graph.AStar(source, target, &a_star_path, &num_settled) == Approx(cost));
+        REQUIRE(num_settled >= 1);
+        REQUIRE(num_settled <= graph.size());
+        if (std::isinf(cost)) {
+          REQUIRE(a_star_path.empty());
+        } else {
+          REQUIRE(a_star_path.front() == source);
+          REQUIRE(a_star_path.back() == target);
+        }
+        // without a heuristic, A* is Dijkstras (for any weight function)
+        REQUIRE(graph.AStar<Graph::NoHeuristic, Graph::MeanDuration>(source, target, &a_star_path, nullptr)
+            == graph.shortestPath<Graph::MeanDuration>(source, target, &path));
+        REQUIRE(a_star_path == path);
+      }
+    }
+  }
+}
+
+TEST_CASE("A* Settles Fewer Verticies Than Dijkstra's", "[Dijkstras][AStar]") {
+  // stations on a grid, joined to their neighbors on the grid
+  Graph graph;
+  const int kGridSize = 30;
+  for (int row = 0; row < kGridSize; ++row) {
+    for (int column = 0; column < kGridSize; ++column) {
+      graph.insertVertex(Graph::Station(row * kGridSize + column, row * 0.01, column * 0.01));
+      if (row > 0) graph.insertEdgeFromData(graph.getVertex((row - 1) * kGridSize + column), graph.getVertex(row * kGridSize + column));
+      if (column > 0) graph.insertEdgeFromData(graph.getVertex(row * kGridSize + column - 1), graph.getVertex(row * kGridSize + column));
+    }
+  }
+
+  std::vector<Graph::VertexData*> path;
+  size_t dijkstras_settled = 0;
+  size_t a_star_settled = 0;
+  Graph::VertexData* source = graph.getVertex(0);
+  Graph::VertexData* target = graph.getVertex(kGridSize - 1);
+  double dijkstras_cost = graph.AStar<Graph::NoHeuristic>(source, target, &path, &dijkstras_settled);
+  REQUIRE(graph.AStar(source, target, &path, &a_star_settled) == Approx(dijkstras_cost));
+  REQUIRE(path.size() == kGridSize);
+  // Dijkstra's settles the whole triangle of verticies closer than the target, A* only the first row
+  REQUIRE(dijkstras_settled >= kGridSize * (kGridSize - 1) / 2);
+  REQUIRE(a_star_settled == kGridSize);
+
+  REQUIRE(graph.AStar(source, source, &path, &a_star_settled) == 0);
+  REQUIRE(path == std::vector<Graph::VertexData*>{source});
+  REQUIRE(a_star_settled == 1);
+}
+
+TEST_CASE("Landmark Bounds Are Lower Bounds", "[Dijkstras][AStar][landmarks]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    Landmarks landmarks(graph, 3);
+    REQUIRE(landmarks.getNumLandmarks() == std::min<size_t>(3, graph.size()));
+
+    std::vector<double> distances;
+    for (Graph::VertexData* source : graph.getVertexList()) {
+      graph.Dijkstras(source, &distances, nullptr);
+      for (Graph::VertexData* target : graph.getVertexList()) {
+        REQUIRE(landmarks.getLowerBound(target, source) <= distances[target->index_]);
+        REQUIRE(landmarks.getLowerBound(source, target) == landmarks.getLowerBound(target, source));
+      }
+    }
+  }
+}
+
+TEST_CASE("Landmarks Are Far Apart", "[landmarks]") {
+  // stations along a line, so the farthest stations are the ends and then the middle
+  Graph graph;
+  for (int id = 0; id < 9; ++id) {
+    graph.insertVertex(Graph::Station(id, 0, id));
+    if (id > 0) graph.insertEdgeFromData(graph.getVertex(id - 1), graph.getVertex(id));
+  }
+  // a second component gets its own landmark
+  graph.insertEdgeFromData(graph.insertVertex(Graph::Station(20, 5, 5)), graph.insertVertex(Graph::Station(21, 5, 6)));
+
+  Landmarks landmarks(graph, 4);
+  std::vector<int> landmark_ids;
+  for (uint32_t landmark : landmarks.getLandmarks()) {
+    landmark_ids.push_back(graph.getVertexByIndex(landmark)->station_.id_);
+  }
+  // the other component can't be reached from the first vertex (station 0), and then none of the
+  // line can be reached from it (so the first vertex is next), then the far end and the middle
+  REQUIRE(landmark_ids.size() == 4);
+  REQUIRE((landmark_ids[0] == 20 || landmark_ids[0] == 21));
+  REQUIRE(landmark_ids[1] == 0);
+  REQUIRE(landmark_ids[2] == 8);
+  REQUIRE(landmark_ids[3] == 4);
+
+  REQUIRE(landmarks.getDistance(2, graph.getVertex(3)->index_) == 5);
+  REQUIRE(landmarks.getLowerBound(graph.getVertex(2), graph.getVertex(7)) == Approx(5));
+  REQUIRE(std::isinf(landmarks.getLowerBound(graph.getVertex(2), graph.getVertex(20))));
+}
+
+TEST_CASE("A* With Landmarks Matches Shortest Path", "[Dijkstras][AStar][landmarks]") {
+  Graph graph;
+  std::mt19937 generator(225);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  for (int id = 0; id < 300; ++id) {
+    graph.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+  }
+  for (int i = 0; i < 900; ++i) {
+    graph.insertEdgeFromData(graph.getVertex(generator() % 300), graph.getVertex(generator() % 300));
+  }
+  Landmarks landmarks(graph, 8);
+
+  std::vector<Graph::VertexData*> path;
+  std::vector<Graph::VertexData*> landmark_path;
+  size_t dijkstras_settled = 0;
+  size_t landmark_settled = 0;
+  size_t total_dijkstras_settled = 0;
+  size_t total_landmark_settled = 0;
+  for (int query = 0; query < 500; ++query) {
+    Graph::VertexData* source = graph.getVertex(generator() % 300);
+    Graph::VertexData* target = graph.getVertex(generator() % 300);
+    double cost = graph.AStar<Graph::NoHeuristic>(source, target, &path, &dijkstras_settled);
+    REQUIRE(graph.AStar(source, target, &landmark_path, &landmark_settled, landmarks.getHeuristic())
+        == Approx(cost));
+    REQUIRE(landmark_path.size() == path.size());
+    total_dijkstras_settled += dijkstras_settled;
+    total_landmark_settled += landmark_settled;
+  }
+  REQUIRE(total_landmark_settled < total_dijkstras_settled / 2);
+}
+
+TEST_CASE("A* With Landmarks Of Trip Durations Matches Shortest Path", "[Dijkstras][AStar][landmarks]") {
+  // edges of the data files have trips, so their mean durations are finite
+  Graph graph;
+  graph.addDataFromFiles({"data/April2020.csv", "data/December2020.csv", "data/February2021.csv",
+      "data/January2021.csv", "data/March2020.csv", "data/March2021.csv", "data/November2020.csv"}, 0);
+  REQUIRE(graph.size() > 0);
+  // tables built with another weight function bound that weight function
+  Landmarks duration_landmarks(graph, 8, Graph::MeanDuration());
+
+  std::vector<Graph::VertexData*> path;
+  std::vector<Graph::VertexData*> landmark_path;
+  size_t num_reachable = 0;
+  for (Graph::VertexData* source : graph.getVertexList()) {
+    std::vector<double> durations;
+    graph.Dijkstras(source, &durations, nullptr, Graph::MeanDuration());
+    for (Graph::VertexData* target : graph.getVertexList()) {
+      double cost = graph.AStar(source, target, &landmark_path, nullptr, duration_landmarks.getHeuristic(),
+          Graph::MeanDuration());
+      if (std::isinf(durations[target->index_])) {
+        REQUIRE(std::isinf(cost));
+        continue;
+      }
+      num_reachable += 1;
+      REQUIRE(duration_landmarks.getLowerBound(source, target) <= durations[target->index_] * (1 + 1e-6));
+      REQUIRE(cost == Approx(durations[target->index_]));
+      REQUIRE(cost == Approx(graph.shortestPath<Graph::MeanDuration>(source, target, &path)));
+    }
+  }
+  REQUIRE(num_reachable > graph.size());
+}
+
+TEST_CASE("Landmarks Save And Load", "[landmarks][snapshot]") {
+  const std::string kLandmarksPath = "tests/test_output.landmarks";
+  Graph graph;
+  graph.addDataFromFile("tests/test_data/dijkstra2_dat.csv");
+  Landmarks landmarks(graph, 2);
+  const uint64_t kGraphChecksum = 225;
+  REQUIRE(landmarks.save(kLandmarksPath, kGraphChecksum));
+
+  Landmarks loaded;
+  REQUIRE(loaded.getNumLandmarks() == 0);
+  // tables of a graph with other edges (a snapshot with another checksum) are not loaded
+  REQUIRE_FALSE(loaded.load(kLandmarksPath, graph, kGraphChecksum + 1));
+  REQUIRE(loaded.getNumLandmarks() == 0);
+  REQUIRE(loaded.load(kLandmarksPath, graph, kGraphChecksum));
+  REQUIRE(loaded.getLandmarks() == landmarks.getLandmarks());
+  for (Graph::VertexData* vertex : graph.getVertexList()) {
+    for (size_t landmark = 0; landmark < landmarks.getNumLandmarks(); ++landmark) {
+      REQUIRE(loaded.getDistance(landmark, vertex->index_) == landmarks.getDistance(landmark, vertex->index_));
+    }
+  }
+
+  // tables of another graph are not loaded
+  Graph other_graph;
+  other_graph.addDataFromFile("tests/test_data/dijkstra1_dat.csv");
+  Landmarks other_landmarks(other_graph, 1);
+  REQUIRE(!other_landmarks.load(kLandmarksPath, other_graph, kGraphChecksum));
+  REQUIRE(other_landmarks.getNumLandmarks() == 1);
+
+  // corrupted tables are not loaded
+  {
+    std::fstream file(kLandmarksPath, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put('\x7f');
+  }
+  REQUIRE(!loaded.load(kLandmarksPath, graph, kGraphChecksum));
+  REQUIRE(!loaded.load("tests/test_data/missing.landmarks", graph, kGraphChecksum));
+  std::remove(kLandmarksPath.c_str());
+}
+
+/**
+ * Checks that a contraction hierarchy finds the same distances as Dijkstra's from every
+ * source_stride-th vertex to every vertex, along paths of edges of the graph
+ */
+template <typename WeightFunction>
+void requireHierarchyMatchesDijkstras(Graph& graph, WeightFunction weight, size_t source_stride = 1) {
+  ContractionHierarchy hierarchy(graph, weight);
+  REQUIRE(hierarchy.size() == graph.size());
+  std::vector<double> distances;
+  std::vector<Graph::VertexData*> path;
+  // one search is kept for every query, so each query starts from the state the last one left
+  ContractionHierarchy::QuerySearch query_search;
+  for (size_t source_index = 0; source_index < graph.size(); source_index += source_stride) {
+    Graph::VertexData* source = graph.getVertexByIndex(static_cast<uint32_t>(source_index));
+    graph.Dijkstras(source, &distances, nullptr, weight);
+    for (Graph::VertexData* target : graph.getVertexList()) {
+      double cost = hierarchy.shortestPath(source, target, &path, nullptr, &query_search);
+      if (std::isinf(distances[target->index_])) {
+        REQUIRE(std::isinf(cost));
+        REQUIRE(path.empty());
+        continue;
+      }
+      REQUIRE(cost == Approx(distances[target->index_]));
+      REQUIRE(path.front() == source);
+      REQUIRE(path.back() == target);
+      double path_weight = 0;
+      for (size_t i = 1; i < path.size(); ++i) {
+        Graph::Edge* edge = graph.getEdge(path[i - 1], path[i]);
+        REQUIRE(edge != nullptr);
+        path_weight += weight(edge);
+      }
+      REQUIRE(path_weight == Approx(cost));
+    }
+  }
+}
+
+TEST_CASE("Contraction Hierarchy Matches Dijkstra's", "[Dijkstras][ContractionHierarchy]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    requireHierarchyMatchesDijkstras(graph, Graph::GeometricDistance());
+    requireHierarchyMatchesDijkstras(graph, Graph::MeanDuration());
+  }
+
+  SECTION("Random graphs") {
+    for (unsigned seed = 0; seed < 4; ++seed) {
+      Graph graph;
+      std::mt19937 generator(seed);
+      std::uniform_real_distribution<double> coordinate(0, 1);
+      for (int id = 0; id < 150; ++id) {
+        graph.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+      }
+      for (int i = 0; i < 100 + 150 * static_cast<int>(seed); ++i) {
+        graph.insertEdgeFromData(graph.getVertex(generator() % 150), graph.getVertex(generator() % 150));
+      }
+      requireHierarchyMatchesDijkstras(graph, Graph::GeometricDistance(), 3);
+    }
+  }
+
+  SECTION("Data files") {
+    Graph graph;
+    graph.addDataFromFiles({"data/April2020.csv", "data/December2020.csv", "data/February2021.csv",
+        "data/January2021.csv", "data/March2020.csv", "data/March2021.csv", "data/November2020.csv"}, 0);
+    REQUIRE(graph.size() > 0);
+    requireHierarchyMatchesDijkstras(graph, Graph::GeometricDistance(), 5);
+    requireHierarchyMatchesDijkstras(graph, Graph::MeanDuration(), 5);
+  }
+}
+
+TEST_CASE("Contraction Hierarchy Edge Cases", "[ContractionHierarchy]") {
+  Graph graph;
+  ContractionHierarchy empty_hierarchy(graph);
+  REQUIRE(empty_hierarchy.size() == 0);
+
+  // a path of three stations: contracting the middle station needs a shortcut
+  Graph::VertexData* first = graph.insertVertex(Graph::Station(0, 0, 0));
+  Graph::VertexData* middle = graph.insertVertex(Graph::Station(1, 0, 1));
+  Graph::VertexData* last = graph.insertVertex(Graph::Station(2, 0, 3));
+  Graph::VertexData* alone = graph.insertVertex(Graph::Station(3, 5, 5));
+  graph.insertEdgeFromData(first, middle);
+  graph.insertEdgeFromData(middle, last);
+  ContractionHierarchy hierarchy(graph);
+
+  std::vector<Graph::VertexData*> path;
+  size_t num_settled = 0;
+  REQUIRE(hierarchy.shortestPath(first, last, &path, &num_settled) == 3);
+  REQUIRE(path == std::vector<Graph::VertexData*>{first, middle, last});
+  REQUIRE(num_settled >= 2);
+  REQUIRE(hierarchy.shortestPath(last, first, nullptr, nullptr) == 3);
+  REQUIRE(hierarchy.shortestPath(middle, middle, &path, nullptr) == 0);
+  REQUIRE(path == std::vector<Graph::VertexData*>{middle});
+  REQUIRE(std::isinf(hierarchy.shortestPath(first, alone, &path, nullptr)));
+  REQUIRE(path.empty());
+
+  // one search can be kept across hierarchies of different sizes
+  ContractionHierarchy::QuerySearch query_search;
+  Graph larger_graph;
+  larger_graph.addDataFromFile("tests/test_data/dijkstra2_dat.csv");
+  ContractionHierarchy larger_hierarchy(larger_graph);
+  Graph::VertexData* larger_source = larger_graph.getVertex(4);
+  Graph::VertexData* larger_target = larger_graph.getVertex(3);
+  double larger_cost = larger_hierarchy.shortestPath(larger_source, larger_target, &path, nullptr);
+  REQUIRE(larger_hierarchy.shortestPath(larger_source, larger_target, &path, nullptr, &query_search) == larger_cost);
+  REQUIRE(hierarchy.shortestPath(first, last, &path, nullptr, &query_search) == 3);
+  REQUIRE(path == std::vector<Graph::VertexData*>{first, middle, last});
+  REQUIRE(std::isinf(hierarchy.shortestPath(first, alone, &path, nullptr, &query_search)));
+  REQUIRE(larger_hierarchy.shortestPath(larger_source, larger_target, &path, nullptr, &query_search) == larger_cost);
+}
+
+TEST_CASE("Distance Matrix Matches Dijkstra's", "[Dijkstras][distanceMatrix]") {
+  for (const std::string& file : kTestDataFiles) {
+    Graph graph;
+    graph.addDataFromFile(file);
+    const std::vector<Graph::VertexData*>& verticies = graph.getVertexList();
+    for (size_t num_threads : {1, 3}) {
+      std::vector<double> matrix = graph.distanceMatrix(verticies, verticies, num_threads);
+      std::vector<double> duration_matrix = graph.distanceMatrix<Graph::MeanDuration>(verticies, verticies, num_threads);
+      REQUIRE(matrix.size() == verticies.size() * verticies.size());
+      std::vector<double> distances;
+      for (size_t row = 0; row < verticies.size(); ++row) {
+        graph.Dijkstras(verticies[row], &distances, nullptr);
+        for (size_t column = 0; column < verticies.size(); ++column) {
+          REQUIRE(matrix[row * verticies.size() + column] == distances[verticies[column]->index_]);
+        }
+        graph.Dijkstras<Graph::MeanDuration>(verticies[row], &distances, nullptr);
+        for (size_t column = 0; column < verticies.size(); ++column) {
+          REQUIRE(duration_matrix[row * verticies.size() + column] == distances[verticies[column]->index_]);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Distance Matrix Of Some Stations", "[distanceMatrix]") {
+  Graph graph;
+  graph.addDataFromFile("tests/test_data/dijkstra2_dat.csv");
+  std::vector<Graph::VertexData*> sources = {graph.getVertex(4), graph.getVertex(0)};
+  // a target can be repeated, and the order of the targets is kept
+  std::vector<Graph::VertexData*> targets = {graph.getVertex(3), graph.getVertex(4), graph.getVertex(3)};
+  std::vector<double> matrix = graph.distanceMatrix(sources, targets, 2);
+  REQUIRE(matrix.size() == 6);
+  std::vector<Graph::VertexData*> path;
+  for (size_t row = 0; row < sources.size(); ++row) {
+    for (size_t column = 0; column < targets.size(); ++column) {
+      REQUIRE(matrix[row * targets.size() + column] == graph.shortestPath(sources[row], targets[column], &path));
+    }
+  }
+  REQUIRE(matrix[1] == 0);
+
+  REQUIRE(graph.distanceMatrix(sources, {}).empty());
+  REQUIRE(graph.distanceMatrix({}, targets).empty());
+}
+
+/**
+ * Test Queries Running At The Same Time
+ */
+TEST_CASE("Queries Run At The Same Time On One Graph", "[DFS][Dijkstras][AStar][threads]") {
+  Graph graph;
+  std::mt19937 generator(118);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  for (int id = 0; id < 200; ++id) {
+    graph.insertVertex(Graph::Station(id, coordinate(generator), coordinate(generator)));
+  }
+  for (int i = 0; i < 500; ++i) {
+    graph.insertEdgeFromData(graph.getVertex(generator() % 200), graph.getVertex(generator() % 200));
+  }
+  const Graph& shared_graph = graph;
+  const std::vector<Graph::VertexData*>& verticies = shared_graph.getVertexList();
+
+  // every query only reads the graph, so each thread's answers match the answers of one thread
+  const size_t kNumThreads = 4;
+  std::vector<std::vector<double>> costs(kNumThreads);
+  std::vector<std::vector<int>> traversals(kNumThreads);
+  std::vector<size_t> num_connected(kNumThreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t thread = 0; thread < kNumThreads; ++thread) {
+    threads.emplace_back([&, thread]() {
+      std::vector<double> distances;
+      std::vector<Graph::VertexData*> path;
+      for (size_t source = 0; source < verticies.size(); source += 7) {
+        shared_graph.Dijkstras(verticies[source], &distances, nullptr);
+        costs[thread].insert(costs[thread].end(), distances.begin(), distances.end());
+        for (size_t target = 0; target < verticies.size(); target += 13) {
+          costs[thread].push_back(shared_graph.AStar(verticies[source], verticies[target], &path, nullptr));
+          costs[thread].push_back(shared_graph.bidirectionalShortestPath(verticies[source], verticies[target], &path));
+        }
+        DFS traversal = DFS(&shared_graph, verticies[source]);
+        for (auto it = traversal.begin(); it != traversal.end(); ++it) {
+          traversals[thread].push_back((*it)->station_.id_);
+        }
+        num_connected[thread] += shared_graph.isConnected();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (size_t thread = 1; thread < kNumThreads; ++thread) {
+    REQUIRE(costs[thread] == costs[0]);
+    REQUIRE(traversals[thread] == traversals[0]);
+    REQUIRE(num_connected[thread] == num_connected[0]);
+  }
+  std::vector<double> distances;
+  graph.Dijkstras(verticies[0], &distances, nullptr);
+  REQUIRE(std::equal(distances.begin(), distances.end(), costs[0].begin()));
+}